@@ -1,9 +1,12 @@
 
 #include <benchmark/benchmark.h>
 
+#include <cmath>
+
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
+#include <glm/gtc/constants.hpp>
 
 #include <glkernel/Kernel.h>
 #include <glkernel/noise.h>
@@ -29,6 +32,16 @@ static void BM_gradientNoise_quadratic(benchmark::State& state) {
     state.SetComplexityN(state.range(0));
 }
 
+static void BM_simplexNoise_quadratic(benchmark::State& state) {
+    auto dkernel = glkernel::dkernel1{state.range(0), state.range(0)};
+
+
+    for (auto _ : state)
+        glkernel::noise::gradient(dkernel, glkernel::noise::GradientNoiseType::Simplex);
+
+    state.SetComplexityN(state.range(0));
+}
+
 static void BM_uniformNoise_quadratic(benchmark::State& state) {
     auto dkernel = glkernel::dkernel1{state.range(0), state.range(0)};
 
@@ -51,6 +64,40 @@ static void BM_normalNoise_quadratic(benchmark::State& state) {
 
 }
 
+// former normal noise (Box-Muller transform), for comparison
+class box_muller_operator
+{
+public:
+    box_muller_operator(size_t, glm::length_t coefficient, glkernel::random::seed_type seed)
+    : m_seed{ seed }
+    , m_coefficient{ coefficient }
+    {
+    }
+
+    double operator()(const size_t index)
+    {
+        auto generator = glkernel::random::philox_engine{ m_seed, index, static_cast<glm::uint32>(m_coefficient) };
+        const auto u1 = 1 - glkernel::random::uniform<double>(generator);
+        const auto u2 = glkernel::random::uniform<double>(generator);
+        return 0.86 * std::sqrt(-2 * std::log(u1)) * std::cos(2 * glm::pi<double>() * u2);
+    }
+
+protected:
+    glkernel::random::seed_type m_seed;
+    glm::length_t m_coefficient;
+};
+
+static void BM_normalNoiseBoxMuller_quadratic(benchmark::State& state) {
+    auto dkernel = glkernel::dkernel1{state.range(0), state.range(0)};
+
+
+    for (auto _ : state)
+        dkernel.for_each<box_muller_operator>(glkernel::random::seed_type{ 0 });
+
+    state.SetComplexityN(state.range(0));
+
+}
+
 static void BM_gradientNoise_cube(benchmark::State& state) {
     auto dkernel = glkernel::dkernel1{state.range(0), state.range(0), state.range(0)};
 
@@ -62,8 +109,90 @@ static void BM_gradientNoise_cube(benchmark::State& state) {
 
 }
 
+static void BM_gradientNoise_bricks(benchmark::State& state) {
+    const auto extent = glm::u32vec3(state.range(0));
+    auto checksum = 0.0;
+
+
+    for (auto _ : state)
+        glkernel::noise::gradient<double>(extent, glm::u32vec3(64), [&](const glkernel::dkernel1 & brick, const glm::u32vec3 &)
+        {
+            checksum += brick[0];
+        }, glkernel::noise::GradientNoiseType::Perlin);
+
+    benchmark::DoNotOptimize(checksum);
+    state.SetComplexityN(state.range(0));
+
+}
+
+static void BM_cellularNoise_quadratic(benchmark::State& state) {
+    auto dkernel = glkernel::dkernel1{state.range(0), state.range(0)};
+
+
+    for (auto _ : state)
+        glkernel::noise::cellular(dkernel, glkernel::noise::CellularNoiseType::F2MinusF1, glkernel::noise::OctaveType::Standard, 3, 4, 0);
+
+    state.SetComplexityN(state.range(0));
+
+}
+
+static void BM_spectralNoise_quadratic(benchmark::State& state) {
+    auto dkernel = glkernel::dkernel1{state.range(0), state.range(0)};
+
+
+    for (auto _ : state)
+        glkernel::noise::spectral(dkernel, glkernel::noise::SpectralNoiseType::Pink, 0);
+
+    state.SetComplexityN(state.range(0));
+
+}
+
+static void BM_vectorGradientNoise_quadratic(benchmark::State& state) {
+    auto dkernel = glkernel::dkernel3{state.range(0), state.range(0)};
+
+
+    for (auto _ : state)
+        glkernel::noise::gradient(dkernel, glkernel::noise::GradientNoiseType::Perlin);
+
+    state.SetComplexityN(state.range(0));
+
+}
+
+static void BM_curlNoise_quadratic(benchmark::State& state) {
+    auto dkernel = glkernel::dkernel3{state.range(0), state.range(0)};
+
+
+    for (auto _ : state)
+        glkernel::noise::curl(dkernel, 3, 5);
+
+    state.SetComplexityN(state.range(0));
+
+}
+
+static void BM_gradientNoise_seeded(benchmark::State& state) {
+    auto dkernel = glkernel::dkernel1{state.range(0), state.range(0)};
+    glkernel::random::seed_type seed = 0;
+
+
+    for (auto _ : state)
+        glkernel::noise::gradient(dkernel, glkernel::noise::GradientNoiseType::Perlin, glkernel::noise::OctaveType::Cloud, 3, 8
+            , glkernel::noise::gradient_context::cached(seed++ % 64, 10));
+
+    state.SetComplexityN(state.range(0));
+
+}
+
 BENCHMARK(BM_gradientNoise_quadratic)->RangeMultiplier(4)->Range(64, 2048)->Complexity();
+BENCHMARK(BM_simplexNoise_quadratic)->RangeMultiplier(4)->Range(64, 2048)->Complexity();
 BENCHMARK(BM_uniformNoise_quadratic)->RangeMultiplier(4)->Range(64, 2048)->Complexity();
 BENCHMARK(BM_normalNoise_quadratic)->RangeMultiplier(4)->Range(64, 2048)->Complexity();
+BENCHMARK(BM_normalNoiseBoxMuller_quadratic)->RangeMultiplier(4)->Range(64, 2048)->Complexity();
+BENCHMARK(BM_cellularNoise_quadratic)->RangeMultiplier(4)->Range(64, 2048)->Complexity();
+BENCHMARK(BM_spectralNoise_quadratic)->RangeMultiplier(4)->Range(64, 2048)->Complexity();
+BENCHMARK(BM_vectorGradientNoise_quadratic)->RangeMultiplier(4)->Range(64, 2048)->Complexity();
+BENCHMARK(BM_curlNoise_quadratic)->RangeMultiplier(4)->Range(64, 2048)->Complexity();
+BENCHMARK(BM_gradientNoise_seeded)->RangeMultiplier(4)->Range(64, 2048)->Complexity();
+BENCHMARK(BM_gradientNoise_cube)->RangeMultiplier(2)->Range(16, 256)->Iterations(1)->Complexity();
+BENCHMARK(BM_gradientNoise_bricks)->RangeMultiplier(2)->Range(64, 512)->Iterations(1)->Complexity();
 
 BENCHMARK_MAIN();
@@ -13,6 +13,15 @@ static void BM_poisson_quad(benchmark::State& state) {
     state.SetComplexityN(state.range(0));
 }
 
+static void BM_poisson_parallel_quad(benchmark::State& state) {
+    auto dkernel = glkernel::dkernel2{state.range(0), state.range(0)};
+
+    for (auto _ : state)
+        glkernel::sample::poisson_square_parallel(dkernel);
+
+    state.SetComplexityN(state.range(0));
+}
+
 static void BM_jittered_quad(benchmark::State& state) {
     auto dkernel = glkernel::dkernel2{state.range(0), state.range(0)};
 
@@ -73,6 +82,15 @@ static void BM_halton_quad(benchmark::State& state) {
     state.SetComplexityN(state.range(0));
 }
 
+static void BM_sobol_quad(benchmark::State& state) {
+    auto dkernel = glkernel::dkernel2{state.range(0), state.range(0)};
+
+    for (auto _ : state)
+        glkernel::sample::sobol(dkernel, true, 0u);
+
+    state.SetComplexityN(state.range(0));
+}
+
 static void BM_haltonSphere_quad(benchmark::State& state) {
     auto dkernel = glkernel::dkernel3{state.range(0), state.range(0)};
 
@@ -93,6 +111,26 @@ static void BM_best_candidate_quad(benchmark::State& state) {
     state.SetComplexityN(state.range(0));
 }
 
+static void BM_best_candidate2_quad(benchmark::State& state) {
+    auto dkernel = glkernel::dkernel2{state.range(0), state.range(0)};
+
+
+    for (auto _ : state)
+        glkernel::sample::best_candidate(dkernel);
+
+    state.SetComplexityN(state.range(0));
+}
+
+static void BM_best_candidate_cube(benchmark::State& state) {
+    auto dkernel = glkernel::dkernel3{state.range(0), state.range(0), state.range(0)};
+
+
+    for (auto _ : state)
+        glkernel::sample::best_candidate(dkernel);
+
+    state.SetComplexityN(state.range(0));
+}
+
 static void BM_goldenPointSet_quad(benchmark::State& state) {
     auto dkernel = glkernel::dkernel2{state.range(0), state.range(0)};
 
@@ -104,12 +142,16 @@ static void BM_goldenPointSet_quad(benchmark::State& state) {
 }
 
 BENCHMARK(BM_poisson_quad)->RangeMultiplier(2)->Range(8, 128)->Iterations(1)->Complexity();
+BENCHMARK(BM_poisson_parallel_quad)->RangeMultiplier(2)->Range(8, 512)->Iterations(1)->Complexity();
 BENCHMARK(BM_jittered_quad)->RangeMultiplier(2)->Range(8, 256)->Iterations(1)->Complexity();
 BENCHMARK(BM_rooks_quad)->RangeMultiplier(2)->Range(8, 256)->Iterations(1)->Complexity();
 BENCHMARK(BM_stratified_quad)->RangeMultiplier(2)->Range(8, 256)->Iterations(1)->Complexity();
-BENCHMARK(BM_hammersley_quad)->RangeMultiplier(2)->Range(8, 256)->Iterations(1)->Complexity();
-BENCHMARK(BM_hammersleySphere_quad)->RangeMultiplier(2)->Range(8, 256)->Iterations(1)->Complexity();
-BENCHMARK(BM_halton_quad)->RangeMultiplier(2)->Range(8, 256)->Iterations(1)->Complexity();
-BENCHMARK(BM_haltonSphere_quad)->RangeMultiplier(2)->Range(8, 256)->Iterations(1)->Complexity();
-BENCHMARK(BM_best_candidate_quad)->RangeMultiplier(2)->Range(8, 32)->Iterations(1)->Complexity();
+BENCHMARK(BM_hammersley_quad)->RangeMultiplier(2)->Range(8, 1024)->Iterations(1)->Complexity();
+BENCHMARK(BM_hammersleySphere_quad)->RangeMultiplier(2)->Range(8, 1024)->Iterations(1)->Complexity();
+BENCHMARK(BM_halton_quad)->RangeMultiplier(2)->Range(8, 1024)->Iterations(1)->Complexity();
+BENCHMARK(BM_sobol_quad)->RangeMultiplier(2)->Range(8, 1024)->Iterations(1)->Complexity();
+BENCHMARK(BM_haltonSphere_quad)->RangeMultiplier(2)->Range(8, 1024)->Iterations(1)->Complexity();
+BENCHMARK(BM_best_candidate_quad)->RangeMultiplier(2)->Range(8, 128)->Iterations(1)->Complexity();
+BENCHMARK(BM_best_candidate2_quad)->RangeMultiplier(2)->Range(8, 128)->Iterations(1)->Complexity();
+BENCHMARK(BM_best_candidate_cube)->RangeMultiplier(2)->Range(4, 32)->Iterations(1)->Complexity();
 BENCHMARK(BM_goldenPointSet_quad)->RangeMultiplier(2)->Range(8, 32)->Iterations(1)->Complexity();
@@ -1,8 +1,11 @@
 
 #include <benchmark/benchmark.h>
 
+#include <glm/vec4.hpp>
+
 #include <glkernel/Kernel.h>
 #include <glkernel/scale.h>
+#include <glkernel/sequence.h>
 
 static void BM_scale_quad(benchmark::State& state) {
     auto dkernel = glkernel::dkernel1{state.range(0), state.range(0)};
@@ -14,4 +17,16 @@ static void BM_scale_quad(benchmark::State& state) {
     state.SetComplexityN(state.range(0));
 }
 
+static void BM_normalize_quad_vec4(benchmark::State& state) {
+    auto fkernel = glkernel::kernel4{state.range(0), state.range(0)};
+    glkernel::sequence::uniform(fkernel, -3.f, 7.f);
+
+
+    for (auto _ : state)
+        glkernel::scale::normalize(fkernel, 0.f, 1.f);
+
+    state.SetComplexityN(state.range(0));
+}
+
 BENCHMARK(BM_scale_quad)->RangeMultiplier(2)->Range(8, 256)->Iterations(1)->Complexity();
+BENCHMARK(BM_normalize_quad_vec4)->RangeMultiplier(4)->Range(64, 4096)->Iterations(1)->Complexity();
@@ -31,6 +31,18 @@ static void BM_permutation_quad(benchmark::State& state) {
 
 }
 
+static void BM_permutation_plan_quad(benchmark::State& state) {
+    auto dkernel = glkernel::dkernel1{state.range(0), state.range(0)};
+
+    const auto plan = glkernel::shuffle::permutation_plan{dkernel.extent(), glm::u32vec3(state.range(0)/2, state.range(0)/2, 1), true};
+
+    for (auto _ : state)
+        plan.apply(dkernel);
+
+    state.SetComplexityN(state.range(0));
+
+}
+
 static void BM_bayer_quad(benchmark::State& state) {
     auto dkernel = glkernel::dkernel1{state.range(0), state.range(0)};
 
@@ -52,5 +64,18 @@ static void BM_random_quad(benchmark::State& state) {
     state.SetComplexityN(state.range(0));
 }
 
+static void BM_random_quad_vec4(benchmark::State& state) {
+    auto fkernel = glkernel::kernel4{state.range(0), state.range(0)};
+
+
+    for (auto _ : state)
+        glkernel::shuffle::random(fkernel, 0, 42u);
+
+    state.SetComplexityN(state.range(0));
+}
+
 BENCHMARK(BM_permutation_quad)->RangeMultiplier(2)->Range(8, 256)->Iterations(1)->Complexity();
-BENCHMARK(BM_bayer_quad)->RangeMultiplier(2)->Range(8, 256)->Iterations(1)->Complexity();
+BENCHMARK(BM_permutation_plan_quad)->RangeMultiplier(2)->Range(8, 256)->Iterations(1)->Complexity();
+BENCHMARK(BM_bayer_quad)->RangeMultiplier(2)->Range(8, 1024)->Iterations(1)->Complexity();
+BENCHMARK(BM_random_quad)->RangeMultiplier(4)->Range(64, 4096)->Iterations(1)->Complexity();
+BENCHMARK(BM_random_quad_vec4)->RangeMultiplier(4)->Range(64, 4096)->Iterations(1)->Complexity();
@@ -1,7 +1,10 @@
 
 #include <benchmark/benchmark.h>
 
+#include <glm/vec2.hpp>
+
 #include <glkernel/Kernel.h>
+#include <glkernel/sample.h>
 #include <glkernel/sort.h>
 
 static void BM_sort_quad(benchmark::State& state) {
@@ -14,4 +17,29 @@ static void BM_sort_quad(benchmark::State& state) {
     state.SetComplexityN(state.range(0));
 }
 
+static void BM_sort_distance_points(benchmark::State& state) {
+    auto fkernel = glkernel::kernel2{state.range(0), state.range(0)};
+    glkernel::sample::stratified(fkernel, 42u);
+
+
+    for (auto _ : state)
+        glkernel::sort::distance(fkernel, {0.f, 0.f});
+
+    state.SetComplexityN(state.range(0));
+}
+
+static void BM_sort_hilbert_points(benchmark::State& state) {
+    auto fkernel = glkernel::kernel2{state.range(0), state.range(0)};
+    glkernel::sample::stratified(fkernel, 42u);
+
+    const auto hilbert = glkernel::sort::hilbert<glm::vec2>{};
+
+    for (auto _ : state)
+        glkernel::sort::by_key(fkernel, hilbert);
+
+    state.SetComplexityN(state.range(0));
+}
+
 BENCHMARK(BM_sort_quad)->RangeMultiplier(2)->Range(8, 256)->Iterations(1)->Complexity();
+BENCHMARK(BM_sort_distance_points)->RangeMultiplier(4)->Range(16, 1024)->Iterations(1)->Complexity();
+BENCHMARK(BM_sort_hilbert_points)->RangeMultiplier(4)->Range(16, 1024)->Iterations(1)->Complexity();
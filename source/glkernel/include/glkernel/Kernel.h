@@ -1,7 +1,8 @@
-
 #pragma once
 
 #include <vector>
+#include <cstddef>
+#include <iterator>
 
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtc/type_precision.hpp>
@@ -19,35 +20,106 @@ template <typename T, typename std::enable_if<!std::is_floating_point<T>::value>
 typename T::value_type * kernel_ptr(std::vector<T> & kernel);
 
 
+// type of a single coefficient of a kernel's value type (e.g., float for glm::vec3)
+template<typename T, typename Enable = void>
+struct kernel_component
+{
+    using type = typename T::value_type;
+};
+
 template<typename T>
-struct tkernel
+struct kernel_component<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+    using type = T;
+};
+
+
+// memory layouts of a kernel's values
+namespace layout
+{
+
+// array of structures: all coefficients of a value are stored interleaved in a single array
+struct aos { };
+
+// structure of arrays: each coefficient is stored in its own contiguous, cache line aligned array
+struct soa { };
+
+// non-owning view: values are stored interleaved in external memory, rows and slices optionally pitched
+struct view { };
+
+} // namespace layout
+
+
+// minimal allocator providing over-aligned memory (e.g., for cache line aligned arrays)
+template<typename T, size_t Alignment>
+struct aligned_allocator
+{
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = aligned_allocator<U, Alignment>;
+    };
+
+    aligned_allocator() = default;
+
+    template<typename U>
+    aligned_allocator(const aligned_allocator<U, Alignment> &);
+
+    T * allocate(size_t n);
+    void deallocate(T * p, size_t n);
+
+    template<typename U>
+    bool operator==(const aligned_allocator<U, Alignment> &) const;
+
+    template<typename U>
+    bool operator!=(const aligned_allocator<U, Alignment> &) const;
+};
+
+
+// extent (32 bit per side) and index/position mapping (size_t) shared by all kernel layouts
+class kernel_extent
+{
+public:
+    kernel_extent(glm::uint32 width, glm::uint32 height, glm::uint32 depth);
+
+    const glm::u32vec3 & extent() const;
+    glm::uint32 width() const;
+    glm::uint32 height() const;
+    glm::uint32 depth() const;
+
+    size_t index(glm::uint32 s = 0, glm::uint32 t = 0, glm::uint32 r = 0) const;
+    glm::u32vec3 position(const size_t index) const;
+
+protected:
+    glm::u32vec3 m_extent;
+};
+
+
+template<typename T, typename Layout = layout::aos>
+struct tkernel : public kernel_extent
 {
 private:
     static std::vector<T> s_type_workaround;
 
+    static_assert(std::is_same<Layout, layout::aos>::value, "unsupported kernel layout");
+
 public:
 
-    tkernel(glm::uint16 width = 1, glm::uint16 height = 1, glm::uint16 depth = 1);
-    tkernel(const glm::u16vec3 & extent);
+    tkernel(glm::uint32 width = 1, glm::uint32 height = 1, glm::uint32 depth = 1);
+    tkernel(const glm::u32vec3 & extent);
 
     static glm::length_t length();
     size_t size() const;
 
-    const glm::u16vec3 & extent() const;
-    glm::uint16 width() const;
-    glm::uint16 height() const;
-    glm::uint16 depth() const;
-
     void reset();
 
-    size_t index(glm::uint16 s = 0, glm::uint16 t = 0, glm::uint16 r = 0) const;
-    glm::u16vec3 position(const size_t index) const;
-
     T & operator[](size_t i);
     const T & operator[](size_t i) const;
 
-    T & value(glm::uint16 s = 0, glm::uint16 t = 0, glm::uint16 r = 0);
-    const T & value(glm::uint16 s = 0, glm::uint16 t = 0, glm::uint16 r = 0) const;
+    T & value(glm::uint32 s = 0, glm::uint32 t = 0, glm::uint32 r = 0);
+    const T & value(glm::uint32 s = 0, glm::uint32 t = 0, glm::uint32 r = 0) const;
 
     auto data() -> decltype(kernel_ptr<T>(s_type_workaround));
     auto data() const -> const decltype(kernel_ptr<T>(s_type_workaround));
@@ -61,7 +133,11 @@ public:
     auto begin() const -> decltype(s_type_workaround.cbegin());
     auto end() const -> decltype(s_type_workaround.cend());
 
-    tkernel trimmed(glm::uint16 width, glm::uint16 height, glm::uint16 depth) const;
+    tkernel trimmed(glm::uint32 width, glm::uint32 height, glm::uint32 depth) const;
+
+    // The for_each variants split the kernel's elements into cache line sized chunks that
+    // are distributed over all threads. Each thread constructs its own operator per coefficient,
+    // hence an operator must not depend on visiting all elements of a coefficient in order.
 
     // index passed to operator (size and coefficient to operator constructor)
     template<typename Operator, typename... Args>
@@ -76,12 +152,310 @@ public:
     void for_each_element(Args&&... args);
 
 protected:
+    static size_t chunk_size();
+
+protected:
+    static const size_t s_cache_line_size = 64;
+
     std::vector<T> m_kernel;
-    glm::u16vec3 m_extent;
+};
+
+
+// proxy reference to a single value of a structure of arrays kernel
+template<typename T>
+class soa_reference
+{
+public:
+    using component_type = typename kernel_component<T>::type;
+
+    soa_reference(component_type * first, size_t pitch);
+
+    operator T() const;
+
+    soa_reference & operator=(const T & value);
+    soa_reference & operator=(const soa_reference & other);
+
+    component_type & operator[](glm::length_t coefficient) const;
+
+protected:
+    component_type * m_first;
+    size_t m_pitch;
+};
+
+
+// Stores each coefficient in its own contiguous array (data(coefficient)), with values accessed
+// through proxy references. Iterators are not provided, hence the operator based functions
+// (for_each variants) and index or position based access are supported.
+template<typename T>
+struct tkernel<T, layout::soa> : public kernel_extent
+{
+public:
+    using component_type = typename kernel_component<T>::type;
+
+    using reference = soa_reference<T>;
+
+    tkernel(glm::uint32 width = 1, glm::uint32 height = 1, glm::uint32 depth = 1);
+    tkernel(const glm::u32vec3 & extent);
+
+    static glm::length_t length();
+    size_t size() const;
+
+    void reset();
+
+    reference operator[](size_t i);
+    T operator[](size_t i) const;
+
+    reference value(glm::uint32 s = 0, glm::uint32 t = 0, glm::uint32 r = 0);
+    T value(glm::uint32 s = 0, glm::uint32 t = 0, glm::uint32 r = 0) const;
+
+    // contiguous, cache line aligned array of a single coefficient of all values
+    component_type * data(glm::length_t coefficient);
+    const component_type * data(glm::length_t coefficient) const;
+
+    tkernel trimmed(glm::uint32 width, glm::uint32 height, glm::uint32 depth) const;
+
+    // index passed to operator (size and coefficient to operator constructor)
+    template<typename Operator, typename... Args>
+    void for_each(Args&&... args);
+
+    // position passed to operator (extent and coefficient to operator constructor)
+    template<typename Operator, typename... Args>
+    void for_each_position(Args&&... args);
+
+    // element passed to operator (extent and coefficient to operator constructor)
+    template<typename Operator, typename... Args>
+    void for_each_element(Args&&... args);
+
+protected:
+    static size_t chunk_size();
+
+protected:
+    static const size_t s_cache_line_size = 64;
+
+    // all coefficient arrays in one allocation, each padded to a multiple of a cache line
+    std::vector<component_type, aligned_allocator<component_type, s_cache_line_size>> m_kernel;
+    size_t m_pitch;
+};
+
+
+// random access iterator over the values of a kernel view in index order (T may be const)
+template<typename T>
+class view_iterator
+{
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = typename std::remove_const<T>::type;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = T *;
+    using reference         = T &;
+
+    view_iterator(const tkernel<value_type, layout::view> * view = nullptr, difference_type index = 0);
+
+    template<typename U, typename std::enable_if<std::is_same<const U, T>::value>::type * = nullptr>
+    view_iterator(const view_iterator<U> & other);
+
+    reference operator*() const;
+    pointer operator->() const;
+    reference operator[](difference_type n) const;
+
+    view_iterator & operator++();
+    view_iterator & operator--();
+    view_iterator operator++(int);
+    view_iterator operator--(int);
+
+    view_iterator & operator+=(difference_type n);
+    view_iterator & operator-=(difference_type n);
+    view_iterator operator+(difference_type n) const;
+    view_iterator operator-(difference_type n) const;
+    difference_type operator-(const view_iterator & other) const;
+
+    bool operator==(const view_iterator & other) const;
+    bool operator!=(const view_iterator & other) const;
+    bool operator< (const view_iterator & other) const;
+    bool operator> (const view_iterator & other) const;
+    bool operator<=(const view_iterator & other) const;
+    bool operator>=(const view_iterator & other) const;
+
+    const tkernel<value_type, layout::view> * view() const;
+    difference_type index() const;
+
+protected:
+    const tkernel<value_type, layout::view> * m_view;
+    difference_type m_index;
+};
+
+
+// Non-owning view onto values stored in external memory, e.g., a mapped buffer or texture, or an
+// array owned by another library. Values are generated in place, avoiding a copy. Rows and slices
+// may be padded to a pitch given in bytes (zero denotes tightly packed values). Copying a view
+// copies the reference to the memory, not the values; the memory has to outlive the view.
+template<typename T>
+struct tkernel<T, layout::view> : public kernel_extent
+{
+public:
+    using component_type = typename kernel_component<T>::type;
+
+    using iterator       = view_iterator<T>;
+    using const_iterator = view_iterator<const T>;
+
+    tkernel(T * data, glm::uint32 width = 1, glm::uint32 height = 1, glm::uint32 depth = 1
+        , size_t row_pitch = 0, size_t slice_pitch = 0);
+    tkernel(T * data, const glm::u32vec3 & extent, size_t row_pitch = 0, size_t slice_pitch = 0);
+
+    // view onto all values of an owning kernel
+    explicit tkernel(tkernel<T> & kernel);
+
+    static glm::length_t length();
+    size_t size() const;
+
+    // distance in bytes between the first values of two consecutive rows and slices, respectively
+    size_t row_pitch() const;
+    size_t slice_pitch() const;
+
+    // true if rows and slices are tightly packed, i.e., values are addressable as a single array
+    bool contiguous() const;
+
+    void reset();
+
+    T & operator[](size_t i);
+    const T & operator[](size_t i) const;
+
+    T & value(glm::uint32 s = 0, glm::uint32 t = 0, glm::uint32 r = 0);
+    const T & value(glm::uint32 s = 0, glm::uint32 t = 0, glm::uint32 r = 0) const;
+
+    // address of the value with the given index within the viewed memory
+    T * element(size_t i) const;
+
+    component_type * data();
+    const component_type * data() const;
+
+    iterator begin();
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+
+    iterator end();
+    const_iterator end() const;
+    const_iterator cend() const;
+
+    // owning copy of the trimmed values
+    tkernel<T> trimmed(glm::uint32 width, glm::uint32 height, glm::uint32 depth) const;
+
+    // index passed to operator (size and coefficient to operator constructor)
+    template<typename Operator, typename... Args>
+    void for_each(Args&&... args);
+
+    // position passed to operator (extent and coefficient to operator constructor)
+    template<typename Operator, typename... Args>
+    void for_each_position(Args&&... args);
+
+    // element passed to operator (extent and coefficient to operator constructor)
+    template<typename Operator, typename... Args>
+    void for_each_element(Args&&... args);
+
+protected:
+    static size_t chunk_size();
+
+protected:
+    static const size_t s_cache_line_size = 64;
+
+    T * m_data;
+
+    size_t m_row_pitch;
+    size_t m_slice_pitch;
+    bool m_contiguous;
+};
+
+template<typename T>
+using tkernel_view = tkernel<T, layout::view>;
+
+
+// compile-time sequence of indices (std::index_sequence requires C++14)
+template<size_t... I>
+struct index_sequence { };
+
+template<typename A, typename B>
+struct concat_index_sequence;
+
+template<size_t... I, size_t... J>
+struct concat_index_sequence<index_sequence<I...>, index_sequence<J...>>
+{
+    using type = index_sequence<I..., (sizeof...(I) + J)...>;
+};
+
+// logarithmic instantiation depth, allowing for large sequences
+template<size_t N>
+struct make_index_sequence
+{
+    using type = typename concat_index_sequence<
+        typename make_index_sequence<N / 2>::type, typename make_index_sequence<N - N / 2>::type>::type;
+};
+
+template<>
+struct make_index_sequence<0>
+{
+    using type = index_sequence<>;
+};
+
+template<>
+struct make_index_sequence<1>
+{
+    using type = index_sequence<0>;
+};
+
+
+// Kernel of fixed extent without any allocation, e.g., for small sample sets, dither matrices,
+// or hemisphere kernels. Generated by the constexpr generators (e.g., sample::hammersley<Kernel>())
+// it is a compile-time constant that can be placed in read-only memory and uploaded as is.
+// The coefficients are stored interleaved (as for tkernel) in a plain component array, since
+// neither glm vectors nor std::array provide constexpr construction and access in C++11.
+template<typename T, glm::uint32 W, glm::uint32 H = 1, glm::uint32 D = 1>
+struct static_tkernel
+{
+public:
+    using value_type     = T;
+    using component_type = typename kernel_component<T>::type;
+
+    static_assert(W > 0 && H > 0 && D > 0, "extent of a static kernel is expected to be non-zero");
+    static_assert(sizeof(T) % sizeof(component_type) == 0, "value type is expected to consist of components only");
+
+    // zero initialized kernel
+    constexpr static_tkernel();
+
+    // kernel with each component given by generator(index, coefficient), a constant expression if
+    // the generator's call operator is constexpr
+    template<typename Generator>
+    static constexpr static_tkernel generate(const Generator & generator);
+
+    static constexpr glm::uint32 width();
+    static constexpr glm::uint32 height();
+    static constexpr glm::uint32 depth();
+
+    static constexpr glm::length_t length();
+    static constexpr size_t size();
+
+    static glm::u32vec3 extent();
+
+    static constexpr size_t index(glm::uint32 s = 0, glm::uint32 t = 0, glm::uint32 r = 0);
+
+    constexpr component_type component(size_t i, glm::length_t coefficient) const;
+
+    T operator[](size_t i) const;
+    T value(glm::uint32 s = 0, glm::uint32 t = 0, glm::uint32 r = 0) const;
+
+    const component_type * data() const;
+
+protected:
+    template<typename Generator, size_t... I>
+    constexpr static_tkernel(const Generator & generator, index_sequence<I...>);
+
+protected:
+    static const size_t s_num_components = static_cast<size_t>(W) * H * D * (sizeof(T) / sizeof(component_type));
+
+    component_type m_kernel[s_num_components];
 };
 
 using kernel1  = tkernel<float>;
-using kernel2  = tkernel<glm::vec2>; 
+using kernel2  = tkernel<glm::vec2>;
 using kernel3  = tkernel<glm::vec3>;
 using kernel4  = tkernel<glm::vec4>;
 
@@ -90,6 +464,26 @@ using dkernel2 = tkernel<glm::dvec2>;
 using dkernel3 = tkernel<glm::dvec3>;
 using dkernel4 = tkernel<glm::dvec4>;
 
+using kernel1_view  = tkernel_view<float>;
+using kernel2_view  = tkernel_view<glm::vec2>;
+using kernel3_view  = tkernel_view<glm::vec3>;
+using kernel4_view  = tkernel_view<glm::vec4>;
+
+using dkernel1_view = tkernel_view<double>;
+using dkernel2_view = tkernel_view<glm::dvec2>;
+using dkernel3_view = tkernel_view<glm::dvec3>;
+using dkernel4_view = tkernel_view<glm::dvec4>;
+
+template<glm::uint32 W, glm::uint32 H = 1, glm::uint32 D = 1> using static_kernel1  = static_tkernel<float, W, H, D>;
+template<glm::uint32 W, glm::uint32 H = 1, glm::uint32 D = 1> using static_kernel2  = static_tkernel<glm::vec2, W, H, D>;
+template<glm::uint32 W, glm::uint32 H = 1, glm::uint32 D = 1> using static_kernel3  = static_tkernel<glm::vec3, W, H, D>;
+template<glm::uint32 W, glm::uint32 H = 1, glm::uint32 D = 1> using static_kernel4  = static_tkernel<glm::vec4, W, H, D>;
+
+template<glm::uint32 W, glm::uint32 H = 1, glm::uint32 D = 1> using static_dkernel1 = static_tkernel<double, W, H, D>;
+template<glm::uint32 W, glm::uint32 H = 1, glm::uint32 D = 1> using static_dkernel2 = static_tkernel<glm::dvec2, W, H, D>;
+template<glm::uint32 W, glm::uint32 H = 1, glm::uint32 D = 1> using static_dkernel3 = static_tkernel<glm::dvec3, W, H, D>;
+template<glm::uint32 W, glm::uint32 H = 1, glm::uint32 D = 1> using static_dkernel4 = static_tkernel<glm::dvec4, W, H, D>;
+
 
 } // namespace glkernel
 
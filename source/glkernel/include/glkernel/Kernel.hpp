@@ -4,6 +4,8 @@
 #include <glkernel/Kernel.h>
 
 #include <cassert>
+#include <cstdint>
+#include <algorithm>
 #include <type_traits>
 
 #include <glm/vec2.hpp>
@@ -42,249 +44,1119 @@ glm::length_t kernel_length(const V & type)
     return type.length();
 }
 
-template<typename T>
-tkernel<T>::tkernel(
-    const glm::uint16 w
-,   const glm::uint16 h
-,   const glm::uint16 d)
+template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
+T & kernel_coefficient(T & value, glm::length_t)
+{
+    return value;
+}
+
+template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
+const T & kernel_coefficient(const T & value, glm::length_t)
+{
+    return value;
+}
+
+template<typename V, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
+typename V::value_type & kernel_coefficient(V & value, const glm::length_t coefficient)
+{
+    return value[coefficient];
+}
+
+template<typename V, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
+const typename V::value_type & kernel_coefficient(const V & value, const glm::length_t coefficient)
+{
+    return value[coefficient];
+}
+
+template<typename T, size_t Alignment>
+template<typename U>
+aligned_allocator<T, Alignment>::aligned_allocator(const aligned_allocator<U, Alignment> &)
+{
+}
+
+template<typename T, size_t Alignment>
+T * aligned_allocator<T, Alignment>::allocate(const size_t n)
+{
+    static_assert(Alignment > 0 && Alignment <= 128 && (Alignment & (Alignment - 1)) == 0
+        , "alignment is expected to be a power of two of at most 128");
+
+    // over-allocate and store the offset to the actual allocation in the byte preceding the aligned pointer
+    const auto raw = static_cast<unsigned char *>(::operator new(n * sizeof(T) + Alignment));
+    const auto offset = Alignment - reinterpret_cast<std::uintptr_t>(raw) % Alignment;
+
+    const auto aligned = raw + offset;
+    aligned[-1] = static_cast<unsigned char>(offset - 1);
+
+    return reinterpret_cast<T *>(aligned);
+}
+
+template<typename T, size_t Alignment>
+void aligned_allocator<T, Alignment>::deallocate(T * const p, const size_t)
+{
+    const auto aligned = reinterpret_cast<unsigned char *>(p);
+    ::operator delete(aligned - (static_cast<size_t>(aligned[-1]) + 1));
+}
+
+template<typename T, size_t Alignment>
+template<typename U>
+bool aligned_allocator<T, Alignment>::operator==(const aligned_allocator<U, Alignment> &) const
+{
+    return true;
+}
+
+template<typename T, size_t Alignment>
+template<typename U>
+bool aligned_allocator<T, Alignment>::operator!=(const aligned_allocator<U, Alignment> &) const
+{
+    return false;
+}
+
+inline kernel_extent::kernel_extent(
+    const glm::uint32 w
+,   const glm::uint32 h
+,   const glm::uint32 d)
 : m_extent { w, h, d }
 {
-    m_kernel.resize(w * h * d);
 }
 
-template<typename T>
-tkernel<T>::tkernel(const glm::u16vec3 & extent)
+inline const glm::u32vec3 & kernel_extent::extent() const
+{
+    return m_extent;
+}
+
+inline glm::uint32 kernel_extent::width() const
+{
+    return m_extent.x;
+}
+
+inline glm::uint32 kernel_extent::height() const
+{
+    return m_extent.y;
+}
+
+inline glm::uint32 kernel_extent::depth() const
+{
+    return m_extent.z;
+}
+
+inline size_t kernel_extent::index(
+    const glm::uint32 s
+,   const glm::uint32 t
+,   const glm::uint32 r) const
+{
+    assert(s < m_extent[0]);
+    assert(t < m_extent[1]);
+    assert(r < m_extent[2]);
+
+    // computed in size_t, since the number of values may exceed the range of a single extent
+    const auto w = static_cast<size_t>(m_extent[0]);
+    return (static_cast<size_t>(r) * m_extent[1] + t) * w + s;
+}
+
+inline glm::u32vec3 kernel_extent::position(const size_t index) const
+{
+    assert(index < static_cast<size_t>(m_extent[0]) * m_extent[1] * m_extent[2]);
+
+    const auto wh = static_cast<size_t>(m_extent[0]) * m_extent[1];
+
+    auto pos = glm::u32vec3{ 0, 0, 0 };
+    pos[2] = static_cast<glm::uint32>(index / wh);
+    pos[1] = static_cast<glm::uint32>(index % wh / m_extent[0]);
+    pos[0] = static_cast<glm::uint32>(index % m_extent[0]);
+
+    return pos;
+}
+
+template<typename T, typename Layout>
+tkernel<T, Layout>::tkernel(
+    const glm::uint32 w
+,   const glm::uint32 h
+,   const glm::uint32 d)
+: kernel_extent{ w, h, d }
+{
+    m_kernel.resize(static_cast<size_t>(w) * h * d);
+}
+
+template<typename T, typename Layout>
+tkernel<T, Layout>::tkernel(const glm::u32vec3 & extent)
 : tkernel{ extent.x, extent.y, extent.z }
 {
 }
 
-template<typename T>
-size_t tkernel<T>::size() const
+template<typename T, typename Layout>
+size_t tkernel<T, Layout>::size() const
 {
     return m_kernel.size();
 }
 
-template<typename T>
-glm::length_t tkernel<T>::length()
+template<typename T, typename Layout>
+glm::length_t tkernel<T, Layout>::length()
 {
     return kernel_length(T{ });
 }
 
+template<typename T, typename Layout>
+void tkernel<T, Layout>::reset()
+{
+    for (auto & v : m_kernel)
+        v = T();
+}
+
+template<typename T, typename Layout>
+tkernel<T, Layout> tkernel<T, Layout>::trimmed(
+    const glm::uint32 width,
+    const glm::uint32 height,
+    const glm::uint32 depth) const
+{
+    assert(width  <= m_extent[0]);
+    assert(height <= m_extent[1]);
+    assert(depth  <= m_extent[2]);
+
+    auto kernel = tkernel<T, Layout>{ width, height, depth };
+
+    for (glm::uint32 r = 0; r < depth; ++r)
+        for (glm::uint32 t = 0; t < height; ++t)
+            for (glm::uint32 s = 0; s < width; ++s)
+                kernel.value(s, t, r) = value(s, t, r);
+
+    return kernel;
+}
+
+template<typename T, typename Layout>
+auto tkernel<T, Layout>::data() -> decltype(kernel_ptr<T>(s_type_workaround))
+{
+    return kernel_ptr(m_kernel);
+}
+
+template<typename T, typename Layout>
+auto tkernel<T, Layout>::data() const -> const decltype(kernel_ptr<T>(s_type_workaround))
+{
+    return kernel_ptr(m_kernel);
+}
+
+template<typename T, typename Layout>
+auto tkernel<T, Layout>::begin() -> decltype(s_type_workaround.begin())
+{
+    return m_kernel.begin();
+}
+
+template<typename T, typename Layout>
+auto tkernel<T, Layout>::begin() const -> decltype(s_type_workaround.cbegin())
+{
+    return m_kernel.cbegin();
+}
+
+template<typename T, typename Layout>
+auto tkernel<T, Layout>::cbegin() const -> decltype(s_type_workaround.cbegin())
+{
+    return m_kernel.cbegin();
+}
+
+template<typename T, typename Layout>
+auto tkernel<T, Layout>::end() -> decltype(s_type_workaround.end())
+{
+    return m_kernel.end();
+}
+
+template<typename T, typename Layout>
+auto tkernel<T, Layout>::end() const -> decltype(s_type_workaround.cend())
+{
+    return m_kernel.cend();
+}
+
+template<typename T, typename Layout>
+auto tkernel<T, Layout>::cend() const -> decltype(s_type_workaround.cend())
+{
+    return m_kernel.cend();
+}
+
+template<typename T, typename Layout>
+T & tkernel<T, Layout>::operator[](const size_t i)
+{
+    assert(i < m_kernel.size());
+    return m_kernel[i];
+}
+
+template<typename T, typename Layout>
+const T & tkernel<T, Layout>::operator[](const size_t i) const
+{
+    assert(i < m_kernel.size());
+    return m_kernel[i];
+}
+
+template<typename T, typename Layout>
+T & tkernel<T, Layout>::value(
+    const glm::uint32 s
+,   const glm::uint32 t
+,   const glm::uint32 r)
+{
+    return m_kernel[index(s, t, r)];
+}
+
+template<typename T, typename Layout>
+const T & tkernel<T, Layout>::value(
+    const glm::uint32 s
+,   const glm::uint32 t
+,   const glm::uint32 r) const
+{
+    return m_kernel[index(s, t, r)];
+}
+
+template<typename T, typename Layout>
+template<typename Operator, typename... Args>
+void tkernel<T, Layout>::for_each(Args&&... args)
+{
+    static const auto l = length();
+
+    auto d = data();
+    const auto s = size();
+
+    const auto chunk = chunk_size();
+    const auto num_chunks = static_cast<long long>((s + chunk - 1) / chunk);
+
+    #pragma omp parallel if(num_chunks > 1)
+    for (glm::length_t coefficient = 0; coefficient < l; ++coefficient)
+    {
+        // every thread uses its own operator, since operators may carry state (e.g., generators);
+        // the arguments are not forwarded, as they are used for every thread and coefficient
+        auto o = Operator(s, coefficient, args...);
+
+        #pragma omp for schedule(static) nowait
+        for (long long c = 0; c < num_chunks; ++c)
+        {
+            const auto last = std::min(static_cast<size_t>(c + 1) * chunk, s);
+            for (size_t i = static_cast<size_t>(c) * chunk; i < last; ++i)
+                d[i * l + coefficient] = o(i);
+        }
+    }
+}
+
+template<typename T, typename Layout>
+template<typename Operator, typename... Args>
+void tkernel<T, Layout>::for_each_position(Args&&... args)
+{
+    static const auto l = length();
+
+    auto d = data();
+    const auto s = size();
+
+    const auto chunk = chunk_size();
+    const auto num_chunks = static_cast<long long>((s + chunk - 1) / chunk);
+
+    #pragma omp parallel if(num_chunks > 1)
+    for (glm::length_t coefficient = 0; coefficient < l; ++coefficient)
+    {
+        // every thread uses its own operator, since operators may carry state (e.g., generators);
+        // the arguments are not forwarded, as they are used for every thread and coefficient
+        auto o = Operator(extent(), coefficient, args...);
+
+        #pragma omp for schedule(static) nowait
+        for (long long c = 0; c < num_chunks; ++c)
+        {
+            const auto last = std::min(static_cast<size_t>(c + 1) * chunk, s);
+            for (size_t i = static_cast<size_t>(c) * chunk; i < last; ++i)
+                d[i * l + coefficient] = o(position(i));
+        }
+    }
+}
+
+template<typename T, typename Layout>
+template<typename Operator, typename... Args>
+void tkernel<T, Layout>::for_each_element(Args&&... args)
+{
+    static const auto l = length();
+
+    auto d = data();
+    const auto s = size();
+
+    const auto chunk = chunk_size();
+    const auto num_chunks = static_cast<long long>((s + chunk - 1) / chunk);
+
+    #pragma omp parallel if(num_chunks > 1)
+    for (glm::length_t coefficient = 0; coefficient < l; ++coefficient)
+    {
+        // every thread uses its own operator, since operators may carry state (e.g., generators);
+        // the arguments are not forwarded, as they are used for every thread and coefficient
+        auto o = Operator(extent(), coefficient, args...);
+
+        #pragma omp for schedule(static) nowait
+        for (long long c = 0; c < num_chunks; ++c)
+        {
+            const auto last = std::min(static_cast<size_t>(c + 1) * chunk, s);
+            for (size_t i = static_cast<size_t>(c) * chunk; i < last; ++i)
+                d[i * l + coefficient] = o(d[i * l + coefficient]);
+        }
+    }
+}
+
+template<typename T, typename Layout>
+size_t tkernel<T, Layout>::chunk_size()
+{
+    // number of elements spanning a single cache line (at least one)
+    return std::max(s_cache_line_size / sizeof(T), static_cast<size_t>(1));
+}
+
 template<typename T>
-const glm::u16vec3 & tkernel<T>::extent() const
+soa_reference<T>::soa_reference(component_type * const first, const size_t pitch)
+: m_first{ first }
+, m_pitch{ pitch }
 {
-    return m_extent;
 }
 
 template<typename T>
-glm::uint16 tkernel<T>::width() const
+soa_reference<T>::operator T() const
 {
-    return m_extent.x;
+    auto value = T{ };
+    for (glm::length_t coefficient = 0; coefficient < kernel_length(value); ++coefficient)
+        kernel_coefficient(value, coefficient) = (*this)[coefficient];
+
+    return value;
 }
 
 template<typename T>
-glm::uint16 tkernel<T>::height() const
+soa_reference<T> & soa_reference<T>::operator=(const T & value)
 {
-    return m_extent.y;
+    for (glm::length_t coefficient = 0; coefficient < kernel_length(value); ++coefficient)
+        (*this)[coefficient] = kernel_coefficient(value, coefficient);
+
+    return *this;
 }
 
 template<typename T>
-glm::uint16 tkernel<T>::depth() const
+soa_reference<T> & soa_reference<T>::operator=(const soa_reference & other)
 {
-    return m_extent.z;
+    return *this = static_cast<T>(other);
 }
 
 template<typename T>
-void tkernel<T>::reset()
+typename soa_reference<T>::component_type & soa_reference<T>::operator[](const glm::length_t coefficient) const
+{
+    return m_first[coefficient * m_pitch];
+}
+
+template<typename T>
+tkernel<T, layout::soa>::tkernel(
+    const glm::uint32 w
+,   const glm::uint32 h
+,   const glm::uint32 d)
+: kernel_extent{ w, h, d }
+{
+    // pad every coefficient array to full cache lines, keeping all arrays aligned
+    const auto chunk = chunk_size();
+    m_pitch = (static_cast<size_t>(w) * h * d + chunk - 1) / chunk * chunk;
+
+    m_kernel.resize(m_pitch * length());
+}
+
+template<typename T>
+tkernel<T, layout::soa>::tkernel(const glm::u32vec3 & extent)
+: tkernel{ extent.x, extent.y, extent.z }
 {
-    for (auto & v : m_kernel)
-        v = T();
 }
 
 template<typename T>
-tkernel<T> tkernel<T>::trimmed(
-    const glm::uint16 width,
-    const glm::uint16 height,
-    const glm::uint16 depth) const
+size_t tkernel<T, layout::soa>::size() const
+{
+    return static_cast<size_t>(m_extent[0]) * m_extent[1] * m_extent[2];
+}
+
+template<typename T>
+glm::length_t tkernel<T, layout::soa>::length()
+{
+    return kernel_length(T{ });
+}
+
+template<typename T>
+void tkernel<T, layout::soa>::reset()
+{
+    std::fill(m_kernel.begin(), m_kernel.end(), component_type{ });
+}
+
+template<typename T>
+tkernel<T, layout::soa> tkernel<T, layout::soa>::trimmed(
+    const glm::uint32 width,
+    const glm::uint32 height,
+    const glm::uint32 depth) const
 {
     assert(width  <= m_extent[0]);
     assert(height <= m_extent[1]);
     assert(depth  <= m_extent[2]);
 
-    auto kernel = tkernel<T>{ width, height, depth };
+    auto kernel = tkernel<T, layout::soa>{ width, height, depth };
 
-    for (glm::uint16 r = 0; r < depth; ++r)
-        for (glm::uint16 t = 0; t < height; ++t)
-            for (glm::uint16 s = 0; s < width; ++s)
+    for (glm::uint32 r = 0; r < depth; ++r)
+        for (glm::uint32 t = 0; t < height; ++t)
+            for (glm::uint32 s = 0; s < width; ++s)
                 kernel.value(s, t, r) = value(s, t, r);
 
     return kernel;
 }
 
 template<typename T>
-auto tkernel<T>::data() -> decltype(kernel_ptr<T>(s_type_workaround))
+auto tkernel<T, layout::soa>::data(const glm::length_t coefficient) -> component_type *
 {
-    return kernel_ptr(m_kernel);
+    assert(coefficient < length());
+    return m_kernel.data() + coefficient * m_pitch;
 }
 
 template<typename T>
-auto tkernel<T>::data() const -> const decltype(kernel_ptr<T>(s_type_workaround))
+auto tkernel<T, layout::soa>::data(const glm::length_t coefficient) const -> const component_type *
 {
-    return kernel_ptr(m_kernel);
+    assert(coefficient < length());
+    return m_kernel.data() + coefficient * m_pitch;
 }
 
 template<typename T>
-auto tkernel<T>::begin() -> decltype(s_type_workaround.begin())
+auto tkernel<T, layout::soa>::operator[](const size_t i) -> reference
 {
-    return m_kernel.begin();
+    assert(i < size());
+    return reference{ m_kernel.data() + i, m_pitch };
 }
 
 template<typename T>
-auto tkernel<T>::begin() const -> decltype(s_type_workaround.cbegin())
+T tkernel<T, layout::soa>::operator[](const size_t i) const
 {
-    return m_kernel.cbegin();
+    assert(i < size());
+    return reference{ const_cast<component_type *>(m_kernel.data()) + i, m_pitch };
 }
 
 template<typename T>
-auto tkernel<T>::cbegin() const -> decltype(s_type_workaround.cbegin())
+auto tkernel<T, layout::soa>::value(
+    const glm::uint32 s
+,   const glm::uint32 t
+,   const glm::uint32 r) -> reference
 {
-    return m_kernel.cbegin();
+    return (*this)[index(s, t, r)];
 }
 
 template<typename T>
-auto tkernel<T>::end() -> decltype(s_type_workaround.end())
+T tkernel<T, layout::soa>::value(
+    const glm::uint32 s
+,   const glm::uint32 t
+,   const glm::uint32 r) const
 {
-    return m_kernel.end();
+    return (*this)[index(s, t, r)];
 }
 
 template<typename T>
-auto tkernel<T>::end() const -> decltype(s_type_workaround.cend())
+template<typename Operator, typename... Args>
+void tkernel<T, layout::soa>::for_each(Args&&... args)
 {
-    return m_kernel.cend();
+    static const auto l = length();
+
+    const auto s = size();
+
+    const auto chunk = chunk_size();
+    const auto num_chunks = static_cast<long long>((s + chunk - 1) / chunk);
+
+    #pragma omp parallel if(num_chunks > 1)
+    for (glm::length_t coefficient = 0; coefficient < l; ++coefficient)
+    {
+        // every thread uses its own operator, since operators may carry state (e.g., generators);
+        // the arguments are not forwarded, as they are used for every thread and coefficient
+        auto o = Operator(s, coefficient, args...);
+        auto d = data(coefficient);
+
+        #pragma omp for schedule(static) nowait
+        for (long long c = 0; c < num_chunks; ++c)
+        {
+            const auto last = std::min(static_cast<size_t>(c + 1) * chunk, s);
+            for (size_t i = static_cast<size_t>(c) * chunk; i < last; ++i)
+                d[i] = o(i);
+        }
+    }
 }
 
 template<typename T>
-auto tkernel<T>::cend() const -> decltype(s_type_workaround.cend())
+template<typename Operator, typename... Args>
+void tkernel<T, layout::soa>::for_each_position(Args&&... args)
 {
-    return m_kernel.cend();
+    static const auto l = length();
+
+    const auto s = size();
+
+    const auto chunk = chunk_size();
+    const auto num_chunks = static_cast<long long>((s + chunk - 1) / chunk);
+
+    #pragma omp parallel if(num_chunks > 1)
+    for (glm::length_t coefficient = 0; coefficient < l; ++coefficient)
+    {
+        // every thread uses its own operator, since operators may carry state (e.g., generators);
+        // the arguments are not forwarded, as they are used for every thread and coefficient
+        auto o = Operator(extent(), coefficient, args...);
+        auto d = data(coefficient);
+
+        #pragma omp for schedule(static) nowait
+        for (long long c = 0; c < num_chunks; ++c)
+        {
+            const auto last = std::min(static_cast<size_t>(c + 1) * chunk, s);
+            for (size_t i = static_cast<size_t>(c) * chunk; i < last; ++i)
+                d[i] = o(position(i));
+        }
+    }
 }
 
 template<typename T>
-T & tkernel<T>::operator[](const size_t i)
+template<typename Operator, typename... Args>
+void tkernel<T, layout::soa>::for_each_element(Args&&... args)
 {
-    assert(i < m_kernel.size());
-    return m_kernel[i];
+    static const auto l = length();
+
+    const auto s = size();
+
+    const auto chunk = chunk_size();
+    const auto num_chunks = static_cast<long long>((s + chunk - 1) / chunk);
+
+    #pragma omp parallel if(num_chunks > 1)
+    for (glm::length_t coefficient = 0; coefficient < l; ++coefficient)
+    {
+        // every thread uses its own operator, since operators may carry state (e.g., generators);
+        // the arguments are not forwarded, as they are used for every thread and coefficient
+        auto o = Operator(extent(), coefficient, args...);
+        auto d = data(coefficient);
+
+        #pragma omp for schedule(static) nowait
+        for (long long c = 0; c < num_chunks; ++c)
+        {
+            const auto last = std::min(static_cast<size_t>(c + 1) * chunk, s);
+            for (size_t i = static_cast<size_t>(c) * chunk; i < last; ++i)
+                d[i] = o(d[i]);
+        }
+    }
 }
 
 template<typename T>
-const T & tkernel<T>::operator[](const size_t i) const
+size_t tkernel<T, layout::soa>::chunk_size()
 {
-    assert(i < m_kernel.size());
-    return m_kernel[i];
+    // number of coefficients spanning a single cache line (at least one)
+    return std::max(s_cache_line_size / sizeof(component_type), static_cast<size_t>(1));
 }
 
+
 template<typename T>
-T & tkernel<T>::value(
-    const glm::uint16 s
-,   const glm::uint16 t
-,   const glm::uint16 r)
+view_iterator<T>::view_iterator(const tkernel<value_type, layout::view> * const view, const difference_type index)
+: m_view{ view }
+, m_index{ index }
 {
-    return m_kernel[index(s, t, r)];
 }
 
 template<typename T>
-const T & tkernel<T>::value(
-    const glm::uint16 s
-,   const glm::uint16 t
-,   const glm::uint16 r) const
+template<typename U, typename std::enable_if<std::is_same<const U, T>::value>::type *>
+view_iterator<T>::view_iterator(const view_iterator<U> & other)
+: m_view{ other.view() }
+, m_index{ other.index() }
 {
-    return m_kernel[index(s, t, r)];
 }
 
 template<typename T>
-size_t tkernel<T>::index(
-    const glm::uint16 s
-,   const glm::uint16 t
-,   const glm::uint16 r) const
+auto view_iterator<T>::operator*() const -> reference
 {
-    assert(s < m_extent[0]);
-    assert(t < m_extent[1]);
-    assert(r < m_extent[2]);
+    return *m_view->element(static_cast<size_t>(m_index));
+}
 
-    return r * m_extent[0] * m_extent[1] + t * m_extent[0] + s;
+template<typename T>
+auto view_iterator<T>::operator->() const -> pointer
+{
+    return m_view->element(static_cast<size_t>(m_index));
 }
 
 template<typename T>
-glm::u16vec3 tkernel<T>::position(const size_t index) const
+auto view_iterator<T>::operator[](const difference_type n) const -> reference
 {
-    assert(index < size());
+    return *m_view->element(static_cast<size_t>(m_index + n));
+}
 
-    const auto wh = m_extent[0] * m_extent[1];
+template<typename T>
+view_iterator<T> & view_iterator<T>::operator++()
+{
+    ++m_index;
+    return *this;
+}
 
-    auto pos = glm::u16vec3{ 0, 0, 0 };
-    pos[2] = static_cast<glm::uint16>(index / wh);
-    pos[1] = static_cast<glm::uint16>(index % wh / m_extent[0]);
-    pos[0] = static_cast<glm::uint16>(index % m_extent[0]);
+template<typename T>
+view_iterator<T> & view_iterator<T>::operator--()
+{
+    --m_index;
+    return *this;
+}
 
-    return pos;
+template<typename T>
+view_iterator<T> view_iterator<T>::operator++(int)
+{
+    auto copy = *this;
+    ++m_index;
+    return copy;
+}
+
+template<typename T>
+view_iterator<T> view_iterator<T>::operator--(int)
+{
+    auto copy = *this;
+    --m_index;
+    return copy;
+}
+
+template<typename T>
+view_iterator<T> & view_iterator<T>::operator+=(const difference_type n)
+{
+    m_index += n;
+    return *this;
+}
+
+template<typename T>
+view_iterator<T> & view_iterator<T>::operator-=(const difference_type n)
+{
+    m_index -= n;
+    return *this;
+}
+
+template<typename T>
+view_iterator<T> view_iterator<T>::operator+(const difference_type n) const
+{
+    return view_iterator{ m_view, m_index + n };
+}
+
+template<typename T>
+view_iterator<T> view_iterator<T>::operator-(const difference_type n) const
+{
+    return view_iterator{ m_view, m_index - n };
+}
+
+template<typename T>
+auto view_iterator<T>::operator-(const view_iterator & other) const -> difference_type
+{
+    return m_index - other.m_index;
+}
+
+template<typename T>
+bool view_iterator<T>::operator==(const view_iterator & other) const
+{
+    return m_index == other.m_index;
+}
+
+template<typename T>
+bool view_iterator<T>::operator!=(const view_iterator & other) const
+{
+    return m_index != other.m_index;
+}
+
+template<typename T>
+bool view_iterator<T>::operator<(const view_iterator & other) const
+{
+    return m_index < other.m_index;
+}
+
+template<typename T>
+bool view_iterator<T>::operator>(const view_iterator & other) const
+{
+    return m_index > other.m_index;
+}
+
+template<typename T>
+bool view_iterator<T>::operator<=(const view_iterator & other) const
+{
+    return m_index <= other.m_index;
+}
+
+template<typename T>
+bool view_iterator<T>::operator>=(const view_iterator & other) const
+{
+    return m_index >= other.m_index;
+}
+
+template<typename T>
+auto view_iterator<T>::view() const -> const tkernel<value_type, layout::view> *
+{
+    return m_view;
+}
+
+template<typename T>
+auto view_iterator<T>::index() const -> difference_type
+{
+    return m_index;
+}
+
+template<typename T>
+tkernel<T, layout::view>::tkernel(
+    T * const data
+,   const glm::uint32 w
+,   const glm::uint32 h
+,   const glm::uint32 d
+,   const size_t row_pitch
+,   const size_t slice_pitch)
+: kernel_extent{ w, h, d }
+, m_data{ data }
+, m_row_pitch{ row_pitch > 0 ? row_pitch : w * sizeof(T) }
+, m_slice_pitch{ slice_pitch > 0 ? slice_pitch : m_row_pitch * h }
+{
+    assert(m_data != nullptr);
+
+    // padding has to preserve the alignment of every value
+    assert(m_row_pitch   >= w * sizeof(T)     && m_row_pitch   % alignof(T) == 0);
+    assert(m_slice_pitch >= m_row_pitch * h   && m_slice_pitch % alignof(T) == 0);
+
+    m_contiguous = m_row_pitch == w * sizeof(T) && m_slice_pitch == m_row_pitch * h;
+}
+
+template<typename T>
+tkernel<T, layout::view>::tkernel(
+    T * const data
+,   const glm::u32vec3 & extent
+,   const size_t row_pitch
+,   const size_t slice_pitch)
+: tkernel{ data, extent.x, extent.y, extent.z, row_pitch, slice_pitch }
+{
+}
+
+template<typename T>
+tkernel<T, layout::view>::tkernel(tkernel<T> & kernel)
+: tkernel{ &kernel[0], kernel.extent() }
+{
+}
+
+template<typename T>
+glm::length_t tkernel<T, layout::view>::length()
+{
+    return kernel_length(T{ });
+}
+
+template<typename T>
+size_t tkernel<T, layout::view>::size() const
+{
+    return static_cast<size_t>(m_extent[0]) * m_extent[1] * m_extent[2];
+}
+
+template<typename T>
+size_t tkernel<T, layout::view>::row_pitch() const
+{
+    return m_row_pitch;
+}
+
+template<typename T>
+size_t tkernel<T, layout::view>::slice_pitch() const
+{
+    return m_slice_pitch;
+}
+
+template<typename T>
+bool tkernel<T, layout::view>::contiguous() const
+{
+    return m_contiguous;
+}
+
+template<typename T>
+void tkernel<T, layout::view>::reset()
+{
+    const auto s = size();
+    for (size_t i = 0; i < s; ++i)
+        *element(i) = T();
+}
+
+template<typename T>
+T * tkernel<T, layout::view>::element(const size_t i) const
+{
+    assert(i < size());
+
+    if (m_contiguous)
+        return m_data + i;
+
+    const auto w  = static_cast<size_t>(m_extent[0]);
+    const auto wh = w * m_extent[1];
+
+    const auto row = reinterpret_cast<unsigned char *>(m_data) + i / wh * m_slice_pitch + i % wh / w * m_row_pitch;
+    return reinterpret_cast<T *>(row) + i % w;
+}
+
+template<typename T>
+T & tkernel<T, layout::view>::operator[](const size_t i)
+{
+    return *element(i);
+}
+
+template<typename T>
+const T & tkernel<T, layout::view>::operator[](const size_t i) const
+{
+    return *element(i);
+}
+
+template<typename T>
+T & tkernel<T, layout::view>::value(
+    const glm::uint32 s
+,   const glm::uint32 t
+,   const glm::uint32 r)
+{
+    return *element(index(s, t, r));
+}
+
+template<typename T>
+const T & tkernel<T, layout::view>::value(
+    const glm::uint32 s
+,   const glm::uint32 t
+,   const glm::uint32 r) const
+{
+    return *element(index(s, t, r));
+}
+
+template<typename T>
+auto tkernel<T, layout::view>::data() -> component_type *
+{
+    return reinterpret_cast<component_type *>(m_data);
+}
+
+template<typename T>
+auto tkernel<T, layout::view>::data() const -> const component_type *
+{
+    return reinterpret_cast<const component_type *>(m_data);
+}
+
+template<typename T>
+auto tkernel<T, layout::view>::begin() -> iterator
+{
+    return iterator{ this, 0 };
+}
+
+template<typename T>
+auto tkernel<T, layout::view>::begin() const -> const_iterator
+{
+    return const_iterator{ this, 0 };
+}
+
+template<typename T>
+auto tkernel<T, layout::view>::cbegin() const -> const_iterator
+{
+    return const_iterator{ this, 0 };
+}
+
+template<typename T>
+auto tkernel<T, layout::view>::end() -> iterator
+{
+    return iterator{ this, static_cast<std::ptrdiff_t>(size()) };
+}
+
+template<typename T>
+auto tkernel<T, layout::view>::end() const -> const_iterator
+{
+    return const_iterator{ this, static_cast<std::ptrdiff_t>(size()) };
+}
+
+template<typename T>
+auto tkernel<T, layout::view>::cend() const -> const_iterator
+{
+    return const_iterator{ this, static_cast<std::ptrdiff_t>(size()) };
+}
+
+template<typename T>
+tkernel<T> tkernel<T, layout::view>::trimmed(
+    const glm::uint32 width,
+    const glm::uint32 height,
+    const glm::uint32 depth) const
+{
+    assert(width  <= m_extent[0]);
+    assert(height <= m_extent[1]);
+    assert(depth  <= m_extent[2]);
+
+    auto kernel = tkernel<T>{ width, height, depth };
+
+    for (glm::uint32 r = 0; r < depth; ++r)
+        for (glm::uint32 t = 0; t < height; ++t)
+            for (glm::uint32 s = 0; s < width; ++s)
+                kernel.value(s, t, r) = value(s, t, r);
+
+    return kernel;
 }
 
 template<typename T>
 template<typename Operator, typename... Args>
-void tkernel<T>::for_each(Args&&... args)
+void tkernel<T, layout::view>::for_each(Args&&... args)
 {
     static const auto l = length();
 
-    auto d = data();
     const auto s = size();
 
-    #pragma omp parallel for
+    const auto chunk = chunk_size();
+    const auto num_chunks = static_cast<long long>((s + chunk - 1) / chunk);
+
+    #pragma omp parallel if(num_chunks > 1)
     for (glm::length_t coefficient = 0; coefficient < l; ++coefficient)
     {
-        auto o = Operator(s, coefficient, std::forward<Args>(args)...);
+        // every thread uses its own operator, since operators may carry state (e.g., generators);
+        // the arguments are not forwarded, as they are used for every thread and coefficient
+        auto o = Operator(s, coefficient, args...);
 
-        for (size_t i = 0; i < s; ++i)
-            d[i * l + coefficient] = o(i);
+        #pragma omp for schedule(static) nowait
+        for (long long c = 0; c < num_chunks; ++c)
+        {
+            const auto last = std::min(static_cast<size_t>(c + 1) * chunk, s);
+            for (size_t i = static_cast<size_t>(c) * chunk; i < last; ++i)
+                kernel_coefficient(*element(i), coefficient) = o(i);
+        }
     }
 }
 
 template<typename T>
 template<typename Operator, typename... Args>
-void tkernel<T>::for_each_position(Args&&... args)
+void tkernel<T, layout::view>::for_each_position(Args&&... args)
 {
     static const auto l = length();
 
-    auto d = data();
     const auto s = size();
 
-    #pragma omp parallel for
+    const auto chunk = chunk_size();
+    const auto num_chunks = static_cast<long long>((s + chunk - 1) / chunk);
+
+    #pragma omp parallel if(num_chunks > 1)
     for (glm::length_t coefficient = 0; coefficient < l; ++coefficient)
     {
-        auto o = Operator(extent(), coefficient, std::forward<Args>(args)...);
+        // every thread uses its own operator, since operators may carry state (e.g., generators);
+        // the arguments are not forwarded, as they are used for every thread and coefficient
+        auto o = Operator(extent(), coefficient, args...);
 
-        for (size_t i = 0; i < s; ++i)
-            d[i * l + coefficient] = o(position(i));
+        #pragma omp for schedule(static) nowait
+        for (long long c = 0; c < num_chunks; ++c)
+        {
+            const auto last = std::min(static_cast<size_t>(c + 1) * chunk, s);
+            for (size_t i = static_cast<size_t>(c) * chunk; i < last; ++i)
+                kernel_coefficient(*element(i), coefficient) = o(position(i));
+        }
     }
 }
 
 template<typename T>
 template<typename Operator, typename... Args>
-void tkernel<T>::for_each_element(Args&&... args)
+void tkernel<T, layout::view>::for_each_element(Args&&... args)
 {
     static const auto l = length();
 
-    auto d = data();
     const auto s = size();
 
-    #pragma omp parallel for
+    const auto chunk = chunk_size();
+    const auto num_chunks = static_cast<long long>((s + chunk - 1) / chunk);
+
+    #pragma omp parallel if(num_chunks > 1)
     for (glm::length_t coefficient = 0; coefficient < l; ++coefficient)
     {
-        auto o = Operator(extent(), coefficient, std::forward<Args>(args)...);
+        // every thread uses its own operator, since operators may carry state (e.g., generators);
+        // the arguments are not forwarded, as they are used for every thread and coefficient
+        auto o = Operator(extent(), coefficient, args...);
 
-        for (size_t i = 0; i < s; ++i)
-            d[i * l + coefficient] = o(d[i * l + coefficient]);
+        #pragma omp for schedule(static) nowait
+        for (long long c = 0; c < num_chunks; ++c)
+        {
+            const auto last = std::min(static_cast<size_t>(c + 1) * chunk, s);
+            for (size_t i = static_cast<size_t>(c) * chunk; i < last; ++i)
+            {
+                auto & v = kernel_coefficient(*element(i), coefficient);
+                v = o(v);
+            }
+        }
     }
 }
 
+template<typename T>
+size_t tkernel<T, layout::view>::chunk_size()
+{
+    // number of elements spanning a single cache line (at least one)
+    return std::max(s_cache_line_size / sizeof(T), static_cast<size_t>(1));
+}
+
+
+template<typename T, glm::uint32 W, glm::uint32 H, glm::uint32 D>
+constexpr static_tkernel<T, W, H, D>::static_tkernel()
+: m_kernel{ }
+{
+}
+
+template<typename T, glm::uint32 W, glm::uint32 H, glm::uint32 D>
+template<typename Generator, size_t... I>
+constexpr static_tkernel<T, W, H, D>::static_tkernel(const Generator & generator, index_sequence<I...>)
+: m_kernel{ generator(I / (sizeof(T) / sizeof(component_type)), static_cast<glm::length_t>(I % (sizeof(T) / sizeof(component_type))))... }
+{
+}
+
+template<typename T, glm::uint32 W, glm::uint32 H, glm::uint32 D>
+template<typename Generator>
+constexpr static_tkernel<T, W, H, D> static_tkernel<T, W, H, D>::generate(const Generator & generator)
+{
+    return static_tkernel{ generator, typename make_index_sequence<s_num_components>::type{ } };
+}
+
+template<typename T, glm::uint32 W, glm::uint32 H, glm::uint32 D>
+constexpr glm::uint32 static_tkernel<T, W, H, D>::width()
+{
+    return W;
+}
+
+template<typename T, glm::uint32 W, glm::uint32 H, glm::uint32 D>
+constexpr glm::uint32 static_tkernel<T, W, H, D>::height()
+{
+    return H;
+}
+
+template<typename T, glm::uint32 W, glm::uint32 H, glm::uint32 D>
+constexpr glm::uint32 static_tkernel<T, W, H, D>::depth()
+{
+    return D;
+}
+
+template<typename T, glm::uint32 W, glm::uint32 H, glm::uint32 D>
+constexpr glm::length_t static_tkernel<T, W, H, D>::length()
+{
+    return static_cast<glm::length_t>(sizeof(T) / sizeof(component_type));
+}
+
+template<typename T, glm::uint32 W, glm::uint32 H, glm::uint32 D>
+constexpr size_t static_tkernel<T, W, H, D>::size()
+{
+    return static_cast<size_t>(W) * H * D;
+}
+
+template<typename T, glm::uint32 W, glm::uint32 H, glm::uint32 D>
+glm::u32vec3 static_tkernel<T, W, H, D>::extent()
+{
+    return glm::u32vec3{ W, H, D };
+}
+
+template<typename T, glm::uint32 W, glm::uint32 H, glm::uint32 D>
+constexpr size_t static_tkernel<T, W, H, D>::index(
+    const glm::uint32 s
+,   const glm::uint32 t
+,   const glm::uint32 r)
+{
+    return (static_cast<size_t>(r) * H + t) * W + s;
+}
+
+template<typename T, glm::uint32 W, glm::uint32 H, glm::uint32 D>
+constexpr auto static_tkernel<T, W, H, D>::component(const size_t i, const glm::length_t coefficient) const -> component_type
+{
+    return m_kernel[i * length() + coefficient];
+}
+
+template<typename T, glm::uint32 W, glm::uint32 H, glm::uint32 D>
+T static_tkernel<T, W, H, D>::operator[](const size_t i) const
+{
+    assert(i < size());
+
+    auto value = T{ };
+    for (glm::length_t coefficient = 0; coefficient < length(); ++coefficient)
+        kernel_coefficient(value, coefficient) = component(i, coefficient);
+
+    return value;
+}
+
+template<typename T, glm::uint32 W, glm::uint32 H, glm::uint32 D>
+T static_tkernel<T, W, H, D>::value(
+    const glm::uint32 s
+,   const glm::uint32 t
+,   const glm::uint32 r) const
+{
+    return (*this)[index(s, t, r)];
+}
+
+template<typename T, glm::uint32 W, glm::uint32 H, glm::uint32 D>
+auto static_tkernel<T, W, H, D>::data() const -> const component_type *
+{
+    return m_kernel;
+}
+
 
 } // namespace glkernel
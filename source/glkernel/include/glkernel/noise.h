@@ -1,13 +1,14 @@
 
 #pragma once
 
+#include <ostream>
 #include <type_traits>
-
-#include <random>
+#include <vector>
 
 #include <glm/gtc/type_precision.hpp>
 
 #include <glkernel/Kernel.h>
+#include <glkernel/random.h>
 
 
 namespace glkernel
@@ -18,24 +19,24 @@ namespace noise
 {
 
 
-template <typename T, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
-void uniform(tkernel<T> & kernel, T range_min, T range_max);
+template <typename T, typename Layout, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
+void uniform(tkernel<T, Layout> & kernel, T range_min, T range_max, random::seed_type seed = random::nondeterministic_seed());
 
-template <typename V, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
-void uniform(tkernel<V> & kernel, typename V::value_type range_min, typename V::value_type range_max);
+template <typename V, typename Layout, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
+void uniform(tkernel<V, Layout> & kernel, typename V::value_type range_min, typename V::value_type range_max, random::seed_type seed = random::nondeterministic_seed());
 
-template <typename V, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
-void uniform(tkernel<V> & kernel, const V & range_min, const V & range_max);
+template <typename V, typename Layout, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
+void uniform(tkernel<V, Layout> & kernel, const V & range_min, const V & range_max, random::seed_type seed = random::nondeterministic_seed());
 
 
-template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
-void normal(tkernel<T> & kernel, T mean, T stddev);
+template<typename T, typename Layout, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
+void normal(tkernel<T, Layout> & kernel, T mean, T stddev, random::seed_type seed = random::nondeterministic_seed());
 
-template <typename V, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
-void normal(tkernel<V> & kernel, typename V::value_type mean, typename V::value_type stddev);
+template <typename V, typename Layout, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
+void normal(tkernel<V, Layout> & kernel, typename V::value_type mean, typename V::value_type stddev, random::seed_type seed = random::nondeterministic_seed());
 
-template <typename V, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
-void normal(tkernel<V> & kernel, const V & mean, const V & stddev);
+template <typename V, typename Layout, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
+void normal(tkernel<V, Layout> & kernel, const V & mean, const V & stddev, random::seed_type seed = random::nondeterministic_seed());
 
 /**
 *  @brief
@@ -60,6 +61,50 @@ enum class OctaveType : unsigned char
 Paper
 };
 
+/**
+*  @brief
+*  Permutation and gradient tables of gradient noise
+*
+*  Noise of frequency 1 << r requires tables of at least 1 << r entries. The standard
+*  context uses Ken Perlin's permutation of 256 entries; seeded contexts (up to 2^16
+*  entries, i.e., frequencies up to 1 << 16) yield distinct noise per seed. Contexts
+*  are immutable, thus, they can be shared between threads and reused across calls.
+*/
+class gradient_context
+{
+public:
+    static const unsigned int s_max_bits = 16;
+
+    // Ken Perlin's permutation, as used by the former implementation
+    static const gradient_context & standard();
+
+    // context of a seed and table size, built on first use and kept for later calls
+    static const gradient_context & cached(random::seed_type seed, unsigned int bits = 8);
+
+    explicit gradient_context(random::seed_type seed, unsigned int bits = 8);
+
+    // tables have 1 << bits entries
+    unsigned int bits() const;
+
+    // hash of a lattice point of frequency 1 << r, wrapping around for tileability
+    glm::uint32 hash(glm::uint32 x, glm::uint32 y, glm::uint32 z, unsigned int r) const;
+
+    // hash selecting the gradient of a vector noise component, the first one using the lattice point's hash
+    glm::uint32 component_hash(glm::uint32 hash, unsigned int component) const;
+
+    // index of the gradient selected by a hash, within the 16 gradients of improved noise
+    unsigned char gradient(glm::uint32 hash) const;
+
+protected:
+    gradient_context();
+
+    unsigned int m_bits;
+    glm::uint32 m_mask;
+
+    std::vector<glm::uint16> m_permutation;
+    std::vector<unsigned char> m_gradients;
+};
+
 /**
 *  @brief
 *  Computes a gradient noise dependingon the GradientNoiseType chosen
@@ -67,7 +112,11 @@ Paper
 *  - Improved tilable 3D perlin noise
 *  - non-tilable simplex noise
 *
-*  Uses the random numbers generated by Ken Perlin for the computation
+*  Kernels of depth 1 are computed using 2D noise (four corners for perlin,
+*  three for simplex noise); 2D perlin noise equals the 3D noise at depth 0.
+*
+*  Uses the random numbers generated by Ken Perlin for the computation, unless a
+*  seeded gradient_context is given
 *
 *  @param[in,out] kernel
 *  The kernel to be modified, size is used for number of samples
@@ -83,14 +132,277 @@ Paper
 *
 *  @param[in,out] octaves
 *  Number of frequencies used for noise generation
+*
+*  @param[in] context
+*  Permutation and gradient tables, providing at least startFrequency + octaves - 1 bits
 */
-template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
-void gradient(tkernel<T> & kernel
+template<typename T, typename Layout, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
+void gradient(tkernel<T, Layout> & kernel
     , const GradientNoiseType noise_type = GradientNoiseType::Perlin
     , const OctaveType octave_type = OctaveType::Standard
     , const unsigned int startFrequency = 3
-    , const unsigned int octaves = 5);
+    , const unsigned int octaves = 5
+    , const gradient_context & context = gradient_context::standard());
+
 
+/**
+*  @brief
+*  Computes a gradient noise volume brick by brick, without allocating the whole volume
+*
+*  The result equals the gradient noise of a kernel of the given extent. Bricks are
+*  generated in parallel and handed to the sink, which is called with one brick at a
+*  time (never concurrently) in unspecified order. Thus, memory is bounded by one
+*  brick per thread.
+*
+*  @param[in] extent
+*  Extent of the whole volume
+*
+*  @param[in] brick_extent
+*  Extent of the bricks, bricks at the volume's border are cropped
+*
+*  @param[in] sink
+*  Callable as sink(const tkernel<T> & brick, const glm::u32vec3 & offset), with the
+*  offset of the brick's first value within the volume, e.g., a volume_writer
+*
+*  @param[in] noise_type
+*  The type of noise to be generated
+*
+*  @param[in] octave_type
+*  Method of combining different octaves
+*
+*  @param[in] startFrequency
+*  Lowest frequency noise is generated at
+*
+*  @param[in,out] octaves
+*  Number of frequencies used for noise generation
+*
+*  @param[in] context
+*  Permutation and gradient tables, providing at least startFrequency + octaves - 1 bits
+*/
+template<typename T, typename Sink, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
+void gradient(const glm::u32vec3 & extent
+    , const glm::u32vec3 & brick_extent
+    , Sink && sink
+    , const GradientNoiseType noise_type = GradientNoiseType::Perlin
+    , const OctaveType octave_type = OctaveType::Standard
+    , const unsigned int startFrequency = 3
+    , const unsigned int octaves = 5
+    , const gradient_context & context = gradient_context::standard());
+
+/**
+*  @brief
+*  Computes vector-valued gradient noise, writing all components in one pass
+*
+*  Every component uses its own gradients, the first one equals the scalar gradient
+*  noise. The components share the hashing of the corners and the interpolation
+*  weights (perlin noise) or the simplex corners and their contribution factors
+*  (simplex noise). See the scalar version for details.
+*/
+template<typename V, typename Layout, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
+void gradient(tkernel<V, Layout> & kernel
+    , const GradientNoiseType noise_type = GradientNoiseType::Perlin
+    , const OctaveType octave_type = OctaveType::Standard
+    , const unsigned int startFrequency = 3
+    , const unsigned int octaves = 5
+    , const gradient_context & context = gradient_context::standard());
+
+/**
+*  @brief
+*  Computes 2D curl noise, i.e., (d/dt, -d/ds) of perlin noise as potential
+*
+*  The field is divergence-free in s and t. Derivatives are computed analytically while
+*  generating the potential and are measured per cell of the start frequency. Octaves
+*  sum up the curl of the potential sum(2^-o * noise(2^(startFrequency + o) * x)).
+*
+*  @param[in,out] kernel
+*  The kernel to be modified, size is used for number of samples
+*
+*  @param[in] startFrequency
+*  Lowest frequency noise is generated at
+*
+*  @param[in] octaves
+*  Number of frequencies used for noise generation
+*
+*  @param[in] context
+*  Permutation and gradient tables, providing at least startFrequency + octaves - 1 bits
+*/
+template<typename T, glm::precision P, typename Layout>
+void curl(tkernel<glm::tvec2<T, P>, Layout> & kernel
+    , const unsigned int startFrequency = 3
+    , const unsigned int octaves = 1
+    , const gradient_context & context = gradient_context::standard());
+
+/**
+*  @brief
+*  Computes 3D curl noise, i.e., the curl of 3-component perlin noise as vector potential
+*
+*  The field is divergence-free, the potential uses 3D noise also for kernels of depth 1.
+*  See the 2D version for details.
+*/
+template<typename T, glm::precision P, typename Layout>
+void curl(tkernel<glm::tvec3<T, P>, Layout> & kernel
+    , const unsigned int startFrequency = 3
+    , const unsigned int octaves = 1
+    , const gradient_context & context = gradient_context::standard());
+
+/**
+*  @brief
+*  Feature of cellular noise
+*/
+enum class CellularNoiseType : unsigned char
+{
+    F1,       ///< distance to the nearest feature point
+    F2,       ///< distance to the second nearest feature point
+    F2MinusF1 ///< difference of both, outlining the cells
+};
+
+/**
+*  @brief
+*  Computes tileable cellular (Worley) noise
+*
+*  Every cell of a grid of (1 << frequency)^3 cells ((1 << frequency)^2 cells for kernels
+*  of depth 1) holds one randomly jittered feature point. Distances, measured in cells,
+*  are found by searching the 3x3x3 (3x3) cells around a sample only, thus, the cost per
+*  value is independent of the frequency.
+*
+*  @param[in,out] kernel
+*  The kernel to be modified, size is used for number of samples
+*
+*  @param[in] noise_type
+*  The feature to be generated
+*
+*  @param[in] octave_type
+*  Method of combining different octaves
+*
+*  @param[in] startFrequency
+*  Lowest frequency noise is generated at
+*
+*  @param[in] octaves
+*  Number of frequencies used for noise generation
+*
+*  @param[in] seed
+*  Seed for the feature points
+*/
+template<typename T, typename Layout, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
+void cellular(tkernel<T, Layout> & kernel
+    , const CellularNoiseType noise_type = CellularNoiseType::F1
+    , const OctaveType octave_type = OctaveType::Standard
+    , const unsigned int startFrequency = 3
+    , const unsigned int octaves = 1
+    , random::seed_type seed = random::nondeterministic_seed());
+
+/**
+*  @brief
+*  Computes tileable cellular (Worley) noise, storing F1 in x and F2 in y
+*
+*  F2 - F1 is y - x for a single octave. See the scalar version for details.
+*/
+template<typename T, glm::precision P, typename Layout>
+void cellular(tkernel<glm::tvec2<T, P>, Layout> & kernel
+    , const OctaveType octave_type = OctaveType::Standard
+    , const unsigned int startFrequency = 3
+    , const unsigned int octaves = 1
+    , random::seed_type seed = random::nondeterministic_seed());
+
+/**
+*  @brief
+*  Power spectrum of spectral noise, i.e., 1/f^beta with the given beta
+*/
+enum class SpectralNoiseType : unsigned char
+{
+    White,  ///< beta = 0
+    Pink,   ///< beta = 1
+    Brown,  ///< beta = 2
+    Blue,   ///< beta = -1
+    Violet  ///< beta = -2
+};
+
+/**
+*  @brief
+*  Radial power spectrum 1/f^beta, usable as spectrum of spectral noise
+*/
+template <typename T>
+struct power_law
+{
+    T beta;
+
+    T operator()(T frequency) const;
+};
+
+/**
+*  @brief
+*  Computes tileable noise with a 1/f^beta power spectrum by shaping white noise in the frequency domain
+*
+*  See the version taking an arbitrary spectrum for details.
+*/
+template<typename T, typename Layout, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
+void spectral(tkernel<T, Layout> & kernel
+    , const SpectralNoiseType noise_type = SpectralNoiseType::Pink
+    , random::seed_type seed = random::nondeterministic_seed());
+
+/**
+*  @brief
+*  Computes tileable noise with a given radial power spectrum by shaping white noise in the frequency domain
+*
+*  Gaussian white noise is scaled by the square root of the spectrum and transformed
+*  by an inverse mixed-radix FFT over the kernel's extent (rows are transformed in
+*  parallel). This costs O(n log n) for any spectrum, provided that the extent has
+*  small prime factors only (lengths with large prime factors are supported but slow).
+*  The result has zero mean and unit standard deviation.
+*
+*  @param[in,out] kernel
+*  The kernel to be modified, size is used for number of samples
+*
+*  @param[in] spectrum
+*  Callable as T spectrum(T frequency), returning the power for a frequency > 0,
+*  measured in cycles per kernel extent (as the frequency of gradient noise).
+*  It is called concurrently.
+*
+*  @param[in] seed
+*  Seed for the white noise
+*/
+template<typename T, typename Layout, typename Spectrum, typename std::enable_if<std::is_floating_point<T>::value
+    && !std::is_same<typename std::decay<Spectrum>::type, SpectralNoiseType>::value>::type * = nullptr>
+void spectral(tkernel<T, Layout> & kernel
+    , Spectrum && spectrum
+    , random::seed_type seed = random::nondeterministic_seed());
+
+/**
+*  @brief
+*  Computes two independent spectral noise fields in x and y, using a single complex FFT
+*/
+template<typename T, glm::precision P, typename Layout>
+void spectral(tkernel<glm::tvec2<T, P>, Layout> & kernel
+    , const SpectralNoiseType noise_type = SpectralNoiseType::Pink
+    , random::seed_type seed = random::nondeterministic_seed());
+
+template<typename T, glm::precision P, typename Layout, typename Spectrum
+    , typename std::enable_if<!std::is_same<typename std::decay<Spectrum>::type, SpectralNoiseType>::value>::type * = nullptr>
+void spectral(tkernel<glm::tvec2<T, P>, Layout> & kernel
+    , Spectrum && spectrum
+    , random::seed_type seed = random::nondeterministic_seed());
+
+/**
+*  @brief
+*  Brick sink writing the values of a volume as raw binary data to a stream
+*
+*  The values are stored in x, y, z order (as in a tkernel), starting at the
+*  stream's position on construction. The stream needs to be seekable, e.g.,
+*  a std::ofstream opened in binary mode.
+*/
+template <typename T>
+class volume_writer
+{
+public:
+    volume_writer(std::ostream & stream, const glm::u32vec3 & extent);
+
+    void operator()(const tkernel<T> & brick, const glm::u32vec3 & offset);
+
+protected:
+    std::ostream & m_stream;
+    const std::streampos m_begin;
+    const glm::u32vec3 m_extent;
+};
 
 } // namespace noise
 
@@ -3,6 +3,18 @@
 
 #include <glkernel/noise.h>
 
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
 #include <glkernel/glm_compatability.h>
 
 
@@ -13,7 +25,7 @@ namespace
 // From // JAVA REFERENCE IMPLEMENTATION OF IMPROVED NOISE - COPYRIGHT 2002 KEN PERLIN. (http://mrl.nyu.edu/~perlin/noise/)
 // and (Improving Noise - Perlin - 2002) - http://mrl.nyu.edu/~perlin/paper445.pdf
 
-const std::vector<unsigned char> perm =
+const unsigned char perm[256] =
 {
     151, 160, 137,  91,  90,  15, 131,  13, 201,  95,  96,  53, 194, 233,   7, 225,
     140,  36, 103,  30,  69, 142,   8,  99,  37, 240,  21,  10,  23, 190,   6, 148,
@@ -33,104 +45,356 @@ const std::vector<unsigned char> perm =
     222, 114,  67,  29,  24,  72, 243, 141, 128, 195,  78,  66, 215,  61, 156, 180
 };
 
-const std::vector<glm::vec3> grad =
+// gradients of improved noise (the last four repeat the first and the tetrahedral ones)
+const signed char grad[16][3] =
 {
-    { 1.0, 1.0, 0.0 }, { -1.0, 1.0, 0.0 }, { 1.0, -1.0, 0.0 }, { -1.0, -1.0, 0.0 },
-    { 1.0, 0.0, 1.0 }, { -1.0, 0.0, 1.0 }, { 1.0, 0.0, -1.0 }, { -1.0, 0.0, -1.0 },
-    { 0.0, 1.0, 1.0 }, { 0.0, -1.0, 1.0 }, { 0.0, 1.0, -1.0 }, { 0.0, -1.0, -1.0 },
-    { 1.0, 1.0, 0.0 }, { -1.0, 1.0, 0.0 }, { 0.0, -1.0, 0.0 }, { 0.0, -1.0, -1.0 }
+    {  1,  1,  0 }, { -1,  1,  0 }, {  1, -1,  0 }, { -1, -1,  0 },
+    {  1,  0,  1 }, { -1,  0,  1 }, {  1,  0, -1 }, { -1,  0, -1 },
+    {  0,  1,  1 }, {  0, -1,  1 }, {  0,  1, -1 }, {  0, -1, -1 },
+    {  1,  1,  0 }, { -1,  1,  0 }, {  0, -1,  0 }, {  0, -1, -1 }
 };
 
-unsigned char hash3(
-    const unsigned int x
+// gradient index of a lattice point
+inline unsigned char hash3(
+    const glkernel::noise::gradient_context & context
+    , const unsigned int x
     , const unsigned int y
     , const unsigned int z
     , const unsigned int r)
 {
-    // the values of x, y and z will be in [0, 1 << r]
-    // the frequency mask is used for returning equal values
-    // for the minimum and the maximum input to ensure tileability
-    unsigned int frequencyMask = 1 << r;
-    assert(frequencyMask <= perm.size());
-    return perm[(perm[(perm[x % frequencyMask] + y) % frequencyMask] + z) % frequencyMask];
+    return context.gradient(context.hash(x, y, z, r));
 }
 
 template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr>
-glm::tvec3<T, glm::highp> grad3(
-    const unsigned int x
-    , const unsigned int y
-    , const unsigned int z
-    , const unsigned int r)
+T smootherstep(const T t)
 {
-    const auto p = hash3(x, y, z, r);
-    return glm::tvec3<T, glm::highp>(grad[p % 16]);
+    return t * t * t * (t * (t * 6 - 15) + 10);
 }
 
-template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr>
-glm::tvec3<T, glm::highp> grad3(
-    glm::tvec3<unsigned int, glm::highp> v
-    , const unsigned int r)
+// derivative of smootherstep
+template<typename T>
+T smootherstep_derivative(const T t)
 {
-    const auto p = hash3(v.x, v.y, v.z, r);
-    return glm::tvec3<T, glm::highp>(grad[p % 16]);
+    return 30 * t * t * (t * (t - 2) + 1);
 }
 
-template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr>
-T smootherstep(const T t)
+// same as glm::mix for scalars
+template<typename T>
+T lerp(const T a, const T b, const T t)
 {
-    return t * t * t * (t * (t * 6 - 15) + 10);
+    return a * (1 - t) + b * t;
 }
 
-template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr>
-T perlin3(
-    const T s
-    , const T t
-    , const T u
-    , const unsigned int r)
+// dot product of a gradient with a corner offset, summed in the order of glm::dot
+template<typename T>
+T dot_grad(const unsigned char gradient, const T x, const T y, const T z)
+{
+    const auto & g = grad[gradient & 15];
+    return g[0] * x + g[1] * y + g[2] * z;
+}
+
+template<typename T>
+T dot_grad(const unsigned char gradient, const T x, const T y)
+{
+    const auto & g = grad[gradient & 15];
+    return g[0] * x + g[1] * y;
+}
+
+// Improved (tileable) perlin noise for a row of samples sharing t and u, i.e., only s varies.
+// The corner gradients of a row only depend on the integer part of s, so they are hashed once
+// per row and octave; the remaining per sample work is branch-free arithmetic on the row buffers.
+template<typename T>
+class perlin_row
+{
+public:
+    perlin_row(const glkernel::noise::gradient_context & context, unsigned int max_frequency, unsigned int components = 1);
+
+    void operator()(const T * s, size_t count, T t, T u, unsigned int r, T * noise);
+
+    // planar noise (u = 0) of a depth-1 kernel, requiring only the four corners of the square
+    void operator()(const T * s, size_t count, T t, unsigned int r, T * noise);
+
+    // vector noise with component c stored at noise[c * count + i], each component using its own
+    // gradients; with derivatives, also the partial derivatives (per cell) in the same layout
+    void operator()(const T * s, size_t count, T t, T u, unsigned int r, unsigned int components
+        , T * noise, T * ds = nullptr, T * dt = nullptr, T * du = nullptr);
+
+    void operator()(const T * s, size_t count, T t, unsigned int r, unsigned int components
+        , T * noise, T * ds = nullptr, T * dt = nullptr);
+
+protected:
+    const glkernel::noise::gradient_context & m_context;
+
+    // gradient indices of the four (t, u) corners per integer s within [0, 1 << r] (and component)
+    std::vector<unsigned char> m_hashes;
+};
+
+
+template<typename T>
+perlin_row<T>::perlin_row(const glkernel::noise::gradient_context & context, const unsigned int max_frequency, const unsigned int components)
+: m_context(context)
+, m_hashes(((1u << max_frequency) + 1) * 4 * components)
+{
+    assert(max_frequency <= context.bits());
+}
+
+template<typename T>
+void perlin_row<T>::operator()(const T * const s, const size_t count, const T t, const T u, const unsigned int r, T * const noise)
 {
+    const auto frequency = 1u << r;
+    assert(m_hashes.size() >= (frequency + 1) * 4);
+
     // scale according to frequency
-    const auto scaled_s = s * (1 << r);
-    const auto scaled_t = t * (1 << r);
-    const auto scaled_u = u * (1 << r);
+    const auto scaled_t = t * static_cast<T>(frequency);
+    const auto scaled_u = u * static_cast<T>(frequency);
+
+    const auto it = static_cast<unsigned int>(std::floor(scaled_t));
+    const auto iu = static_cast<unsigned int>(std::floor(scaled_u));
 
-    const auto is = static_cast<unsigned int>(floor(scaled_s));
-    const auto it = static_cast<unsigned int>(floor(scaled_t));
-    const auto iu = static_cast<unsigned int>(floor(scaled_u));
+    const auto ft = scaled_t - std::floor(scaled_t);
+    const auto fu = scaled_u - std::floor(scaled_u);
 
-    const auto f = glm::fract(glm::tvec3<T, glm::highp>(scaled_s, scaled_t, scaled_u));
+    const auto st = smootherstep(ft);
+    const auto su = smootherstep(fu);
 
-    // range [-1;+1]
+    for (unsigned int is = 0; is <= frequency; ++is)
+    {
+        m_hashes[is * 4 + 0] = hash3(m_context, is, it + 0, iu + 0, r);
+        m_hashes[is * 4 + 1] = hash3(m_context, is, it + 0, iu + 1, r);
+        m_hashes[is * 4 + 2] = hash3(m_context, is, it + 1, iu + 0, r);
+        m_hashes[is * 4 + 3] = hash3(m_context, is, it + 1, iu + 1, r);
+    }
+
+    const auto hashes = m_hashes.data();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto scaled_s = s[i] * static_cast<T>(frequency);
+        const auto is = static_cast<unsigned int>(std::floor(scaled_s));
+        const auto fs = scaled_s - std::floor(scaled_s);
+
+        const auto a = hashes + is * 4;
+        const auto b = a + 4;
+
+        // range [-1;+1]
+        const auto aaa = dot_grad(a[0], fs, ft, fu);
+        const auto baa = dot_grad(b[0], fs - 1, ft, fu);
+        const auto aba = dot_grad(a[2], fs, ft - 1, fu);
+        const auto bba = dot_grad(b[2], fs - 1, ft - 1, fu);
+        const auto aab = dot_grad(a[1], fs, ft, fu - 1);
+        const auto bab = dot_grad(b[1], fs - 1, ft, fu - 1);
+        const auto abb = dot_grad(a[3], fs, ft - 1, fu - 1);
+        const auto bbb = dot_grad(b[3], fs - 1, ft - 1, fu - 1);
+
+        // interpolate noise values of the eight corners
+        const auto ss = smootherstep(fs);
+        const auto i0 = lerp(aaa, baa, ss);
+        const auto i1 = lerp(aab, bab, ss);
+        const auto i2 = lerp(aba, bba, ss);
+        const auto i3 = lerp(abb, bbb, ss);
+
+        noise[i] = lerp(lerp(i0, i2, st), lerp(i1, i3, st), su);
+    }
+}
+
+template<typename T>
+void perlin_row<T>::operator()(const T * const s, const size_t count, const T t, const unsigned int r, T * const noise)
+{
+    const auto frequency = 1u << r;
+    assert(m_hashes.size() >= (frequency + 1) * 2);
+
+    // for u = 0 the interpolation along u yields the lower four corners (smootherstep(0) = 0)
+    // and their gradients' u components do not contribute, so this equals the 3D noise
+    const auto scaled_t = t * static_cast<T>(frequency);
+    const auto it = static_cast<unsigned int>(std::floor(scaled_t));
+    const auto ft = scaled_t - std::floor(scaled_t);
+    const auto st = smootherstep(ft);
+
+    for (unsigned int is = 0; is <= frequency; ++is)
+    {
+        m_hashes[is * 2 + 0] = hash3(m_context, is, it + 0, 0, r);
+        m_hashes[is * 2 + 1] = hash3(m_context, is, it + 1, 0, r);
+    }
+
+    const auto hashes = m_hashes.data();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto scaled_s = s[i] * static_cast<T>(frequency);
+        const auto is = static_cast<unsigned int>(std::floor(scaled_s));
+        const auto fs = scaled_s - std::floor(scaled_s);
 
-    const auto aaa = glm::dot(grad3<T>(is + 0, it + 0, iu + 0, r), f);
-    const auto baa = glm::dot(grad3<T>(is + 1, it + 0, iu + 0, r), f - glm::tvec3<T, glm::highp>(1., 0., 0.));
-    const auto aba = glm::dot(grad3<T>(is + 0, it + 1, iu + 0, r), f - glm::tvec3<T, glm::highp>(0., 1., 0.));
-    const auto bba = glm::dot(grad3<T>(is + 1, it + 1, iu + 0, r), f - glm::tvec3<T, glm::highp>(1., 1., 0.));
-    const auto aab = glm::dot(grad3<T>(is + 0, it + 0, iu + 1, r), f - glm::tvec3<T, glm::highp>(0., 0., 1.));
-    const auto bab = glm::dot(grad3<T>(is + 1, it + 0, iu + 1, r), f - glm::tvec3<T, glm::highp>(1., 0., 1.));
-    const auto abb = glm::dot(grad3<T>(is + 0, it + 1, iu + 1, r), f - glm::tvec3<T, glm::highp>(0., 1., 1.));
-    const auto bbb = glm::dot(grad3<T>(is + 1, it + 1, iu + 1, r), f - glm::tvec3<T, glm::highp>(1., 1., 1.));
+        const auto a = hashes + is * 2;
+        const auto b = a + 2;
 
-    // interpolate noise values of the eight corners
-    const auto i = glm::mix(
-        glm::tvec4<T, glm::highp>(aaa, aab, aba, abb),
-        glm::tvec4<T, glm::highp>(baa, bab, bba, bbb),
-        smootherstep(f[0]));
-    const auto j = glm::mix(
-        glm::tvec2<T, glm::highp>(i[0], i[1]),
-        glm::tvec2<T, glm::highp>(i[2], i[3]),
-        smootherstep(f[1]));
+        const auto aa = dot_grad(a[0], fs, ft);
+        const auto ba = dot_grad(b[0], fs - 1, ft);
+        const auto ab = dot_grad(a[1], fs, ft - 1);
+        const auto bb = dot_grad(b[1], fs - 1, ft - 1);
 
-    return glm::mix(j[0], j[1], smootherstep(f[2]));
+        const auto ss = smootherstep(fs);
+        noise[i] = lerp(lerp(aa, ba, ss), lerp(ab, bb, ss), st);
+    }
+}
+
+template<typename T>
+void perlin_row<T>::operator()(const T * const s, const size_t count, const T t, const T u, const unsigned int r, const unsigned int components
+    , T * const noise, T * const ds, T * const dt, T * const du)
+{
+    const auto frequency = 1u << r;
+    assert(m_hashes.size() >= (frequency + 1) * 4 * components);
+
+    const auto scaled_t = t * static_cast<T>(frequency);
+    const auto scaled_u = u * static_cast<T>(frequency);
+
+    const auto it = static_cast<unsigned int>(std::floor(scaled_t));
+    const auto iu = static_cast<unsigned int>(std::floor(scaled_u));
+
+    const auto ft = scaled_t - std::floor(scaled_t);
+    const auto fu = scaled_u - std::floor(scaled_u);
+
+    const auto st = smootherstep(ft);
+    const auto su = smootherstep(fu);
+    const auto dst = smootherstep_derivative(ft);
+    const auto dsu = smootherstep_derivative(fu);
+
+    // the corners are hashed once, the components derive their gradients from these hashes
+    for (unsigned int is = 0; is <= frequency; ++is)
+    {
+        const glm::uint32 corners[4] = {
+            m_context.hash(is, it + 0, iu + 0, r), m_context.hash(is, it + 0, iu + 1, r),
+            m_context.hash(is, it + 1, iu + 0, r), m_context.hash(is, it + 1, iu + 1, r) };
+
+        for (unsigned int c = 0; c < components; ++c)
+            for (unsigned int corner = 0; corner < 4; ++corner)
+                m_hashes[(is * components + c) * 4 + corner] = m_context.gradient(m_context.component_hash(corners[corner], c));
+    }
+
+    const auto hashes = m_hashes.data();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto scaled_s = s[i] * static_cast<T>(frequency);
+        const auto is = static_cast<unsigned int>(std::floor(scaled_s));
+        const auto fs = scaled_s - std::floor(scaled_s);
+
+        const auto ss = smootherstep(fs);
+        const auto dss = smootherstep_derivative(fs);
+
+        for (unsigned int c = 0; c < components; ++c)
+        {
+            const auto a = hashes + (is * components + c) * 4;
+            const auto b = a + components * 4;
+
+            const auto aaa = dot_grad(a[0], fs, ft, fu);
+            const auto baa = dot_grad(b[0], fs - 1, ft, fu);
+            const auto aba = dot_grad(a[2], fs, ft - 1, fu);
+            const auto bba = dot_grad(b[2], fs - 1, ft - 1, fu);
+            const auto aab = dot_grad(a[1], fs, ft, fu - 1);
+            const auto bab = dot_grad(b[1], fs - 1, ft, fu - 1);
+            const auto abb = dot_grad(a[3], fs, ft - 1, fu - 1);
+            const auto bbb = dot_grad(b[3], fs - 1, ft - 1, fu - 1);
+
+            const auto i0 = lerp(aaa, baa, ss);
+            const auto i1 = lerp(aab, bab, ss);
+            const auto i2 = lerp(aba, bba, ss);
+            const auto i3 = lerp(abb, bbb, ss);
+
+            noise[c * count + i] = lerp(lerp(i0, i2, st), lerp(i1, i3, st), su);
+
+            if (!ds)
+                continue;
+
+            // derivative = interpolated corner gradients + derivative of the interpolation weights
+            const signed char * const g[8] = {
+                grad[a[0] & 15], grad[b[0] & 15], grad[a[2] & 15], grad[b[2] & 15],
+                grad[a[1] & 15], grad[b[1] & 15], grad[a[3] & 15], grad[b[3] & 15] };
+
+            T gradient[3];
+            for (unsigned int k = 0; k < 3; ++k)
+            {
+                gradient[k] = lerp(
+                    lerp(lerp<T>(g[0][k], g[1][k], ss), lerp<T>(g[2][k], g[3][k], ss), st),
+                    lerp(lerp<T>(g[4][k], g[5][k], ss), lerp<T>(g[6][k], g[7][k], ss), st), su);
+            }
+
+            ds[c * count + i] = gradient[0] + dss * lerp(lerp(baa - aaa, bba - aba, st), lerp(bab - aab, bbb - abb, st), su);
+            dt[c * count + i] = gradient[1] + dst * lerp(lerp(aba - aaa, bba - baa, ss), lerp(abb - aab, bbb - bab, ss), su);
+            du[c * count + i] = gradient[2] + dsu * lerp(lerp(aab - aaa, bab - baa, ss), lerp(abb - aba, bbb - bba, ss), st);
+        }
+    }
+}
+
+template<typename T>
+void perlin_row<T>::operator()(const T * const s, const size_t count, const T t, const unsigned int r, const unsigned int components
+    , T * const noise, T * const ds, T * const dt)
+{
+    const auto frequency = 1u << r;
+    assert(m_hashes.size() >= (frequency + 1) * 2 * components);
+
+    const auto scaled_t = t * static_cast<T>(frequency);
+    const auto it = static_cast<unsigned int>(std::floor(scaled_t));
+    const auto ft = scaled_t - std::floor(scaled_t);
+    const auto st = smootherstep(ft);
+    const auto dst = smootherstep_derivative(ft);
+
+    for (unsigned int is = 0; is <= frequency; ++is)
+    {
+        const glm::uint32 corners[2] = { m_context.hash(is, it + 0, 0, r), m_context.hash(is, it + 1, 0, r) };
+
+        for (unsigned int c = 0; c < components; ++c)
+            for (unsigned int corner = 0; corner < 2; ++corner)
+                m_hashes[(is * components + c) * 2 + corner] = m_context.gradient(m_context.component_hash(corners[corner], c));
+    }
+
+    const auto hashes = m_hashes.data();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto scaled_s = s[i] * static_cast<T>(frequency);
+        const auto is = static_cast<unsigned int>(std::floor(scaled_s));
+        const auto fs = scaled_s - std::floor(scaled_s);
+
+        const auto ss = smootherstep(fs);
+        const auto dss = smootherstep_derivative(fs);
+
+        for (unsigned int c = 0; c < components; ++c)
+        {
+            const auto a = hashes + (is * components + c) * 2;
+            const auto b = a + components * 2;
+
+            const auto aa = dot_grad(a[0], fs, ft);
+            const auto ba = dot_grad(b[0], fs - 1, ft);
+            const auto ab = dot_grad(a[1], fs, ft - 1);
+            const auto bb = dot_grad(b[1], fs - 1, ft - 1);
+
+            noise[c * count + i] = lerp(lerp(aa, ba, ss), lerp(ab, bb, ss), st);
+
+            if (!ds)
+                continue;
+
+            const auto & gaa = grad[a[0] & 15];
+            const auto & gba = grad[b[0] & 15];
+            const auto & gab = grad[a[1] & 15];
+            const auto & gbb = grad[b[1] & 15];
+
+            ds[c * count + i] = lerp(lerp<T>(gaa[0], gba[0], ss), lerp<T>(gab[0], gbb[0], ss), st) + dss * lerp(ba - aa, bb - ab, st);
+            dt[c * count + i] = lerp(lerp<T>(gaa[1], gba[1], ss), lerp<T>(gab[1], gbb[1], ss), st) + dst * lerp(ab - aa, bb - ba, ss);
+        }
+    }
 }
 
 // adapted from example code by Stefan Gustavson (stegu@itn.liu.se)
 // (http://webstaff.itn.liu.se/~stegu/simplexnoise/SimplexNoise.java)
+// The corners and their contribution factors are computed once for all components of a vector noise,
+// which only differ in the corner gradients (see gradient_context::component_hash); component c is
+// written to noise[c * stride].
 template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr>
-T simplex3(
-    const T s
+void simplex3(
+    const glkernel::noise::gradient_context & context
+    , const T s
     , const T t
     , const T u
-    , const unsigned int r)
+    , const unsigned int r
+    , const unsigned int components
+    , T * const noise
+    , const size_t stride)
 {
     const T skew_constant = 1 / static_cast<T>(3);
     const T unskew_constant = 1 / static_cast<T>(6);
@@ -144,62 +408,115 @@ T simplex3(
     const T unskew_factor = (corner.x + corner.y + corner.z) * unskew_constant;
     const glm::tvec3<T, glm::highp> v0 = scaled_pos + unskew_factor - static_cast<glm::tvec3<T, glm::highp>>(corner);
     // for the 3D case, the simplex shape is a slightly irregular tetrahedron.
-    // determine corner offsets in skewed space for specific simplex
-    glm::tvec3<unsigned int, glm::highp> corner_offset1;
-    glm::tvec3<unsigned int, glm::highp> corner_offset2;
-    if (v0.x >= v0.y)
-    {
-        if (v0.y >= v0.z)
-        {
-            corner_offset1 = {1, 0, 0};
-            corner_offset2 = {1, 1, 0};
-        } // X Y Z order
-        else if (v0.x >= v0.z)
-        {
-            corner_offset1 = {1, 0, 0};
-            corner_offset2 = {1, 0, 1};
-        } // X Z Y order
-        else
-        {
-            corner_offset1 = {0, 0, 1};
-            corner_offset2 = {1, 0, 1};
-        } // Z X Y order
-    }
-    else
-    { // v0.x < v0.y
-        if (v0.y < v0.z)
-        {
-            corner_offset1 = {0, 0, 1};
-            corner_offset2 = {0, 1, 1};
-        } // Z Y X order
-        else if (v0.x < v0.z)
-        {
-            corner_offset1 = {0, 1, 0};
-            corner_offset2 = {0, 1, 1};
-        } // Y Z X order
-        else
-        {
-            corner_offset1 = {0, 1, 0};
-            corner_offset2 = {1, 1, 0};
-        } // Y X Z order
-    }
+    // determine corner offsets in skewed space for specific simplex (branch-free ranking)
+    const auto x_ge_y = static_cast<unsigned int>(v0.x >= v0.y);
+    const auto y_ge_z = static_cast<unsigned int>(v0.y >= v0.z);
+    const auto x_ge_z = static_cast<unsigned int>(v0.x >= v0.z);
+    const glm::tvec3<unsigned int, glm::highp> corner_offset1 = {
+        x_ge_y & x_ge_z, (1u - x_ge_y) & y_ge_z, (1u - x_ge_z) & (1u - y_ge_z) };
+    const glm::tvec3<unsigned int, glm::highp> corner_offset2 = {
+        x_ge_y | x_ge_z, (1u - x_ge_y) | y_ge_z, (1u - x_ge_z) | (1u - y_ge_z) };
     // corner offsets in (x,y,z) space
     const glm::tvec3<T, glm::highp> v1 = v0 +      unskew_constant - static_cast<glm::tvec3<T, glm::highp>>(corner_offset1);
     const glm::tvec3<T, glm::highp> v2 = v0 +  2 * unskew_constant - static_cast<glm::tvec3<T, glm::highp>>(corner_offset2);
     const glm::tvec3<T, glm::highp> v3 = v0 + (3 * unskew_constant - 1);
     // contribution factors
-    const T t0 = static_cast<T>(0.5) - glm::dot(v0, v0);
-    const T t1 = static_cast<T>(0.5) - glm::dot(v1, v1);
-    const T t2 = static_cast<T>(0.5) - glm::dot(v2, v2);
-    const T t3 = static_cast<T>(0.5) - glm::dot(v3, v3);
+    const T t0 = glm::max(static_cast<T>(0.5) - glm::dot(v0, v0), static_cast<T>(0));
+    const T t1 = glm::max(static_cast<T>(0.5) - glm::dot(v1, v1), static_cast<T>(0));
+    const T t2 = glm::max(static_cast<T>(0.5) - glm::dot(v2, v2), static_cast<T>(0));
+    const T t3 = glm::max(static_cast<T>(0.5) - glm::dot(v3, v3), static_cast<T>(0));
     // Calculate the contribution from the four corners
-    const T n0 = (t0 < 0) ? 0 : (std::pow(t0, 4) * glm::dot(grad3<T>(corner,                  r), v0));
-    const T n1 = (t1 < 0) ? 0 : (std::pow(t1, 4) * glm::dot(grad3<T>(corner + corner_offset1, r), v1));
-    const T n2 = (t2 < 0) ? 0 : (std::pow(t2, 4) * glm::dot(grad3<T>(corner + corner_offset2, r), v2));
-    const T n3 = (t3 < 0) ? 0 : (std::pow(t3, 4) * glm::dot(grad3<T>(corner + 1u,             r), v3));
-    // Add contributions from each corner to get the final noise value.
-    // The result is scaled to stay just inside [-1,1]
-    return 32 * (n0 + n1 + n2 + n3);
+    const glm::tvec3<unsigned int, glm::highp> c1 = corner + corner_offset1;
+    const glm::tvec3<unsigned int, glm::highp> c2 = corner + corner_offset2;
+    const auto h0 = context.hash(corner.x,     corner.y,     corner.z,     r);
+    const auto h1 = context.hash(c1.x,         c1.y,         c1.z,         r);
+    const auto h2 = context.hash(c2.x,         c2.y,         c2.z,         r);
+    const auto h3 = context.hash(corner.x + 1, corner.y + 1, corner.z + 1, r);
+    for (unsigned int c = 0; c < components; ++c)
+    {
+        const T n0 = (t0 * t0) * (t0 * t0) * dot_grad(context.gradient(context.component_hash(h0, c)), v0.x, v0.y, v0.z);
+        const T n1 = (t1 * t1) * (t1 * t1) * dot_grad(context.gradient(context.component_hash(h1, c)), v1.x, v1.y, v1.z);
+        const T n2 = (t2 * t2) * (t2 * t2) * dot_grad(context.gradient(context.component_hash(h2, c)), v2.x, v2.y, v2.z);
+        const T n3 = (t3 * t3) * (t3 * t3) * dot_grad(context.gradient(context.component_hash(h3, c)), v3.x, v3.y, v3.z);
+        // Add contributions from each corner to get the final noise value.
+        // The result is scaled to stay just inside [-1,1]
+        noise[c * stride] = 32 * (n0 + n1 + n2 + n3);
+    }
+}
+
+template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr>
+T simplex3(
+    const glkernel::noise::gradient_context & context
+    , const T s
+    , const T t
+    , const T u
+    , const unsigned int r)
+{
+    auto noise = T{ 0 };
+    simplex3(context, s, t, u, r, 1, &noise, 1);
+    return noise;
+}
+
+// 2D simplex noise for depth-1 kernels, with three corners per triangle instead of four per tetrahedron
+template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr>
+void simplex2(
+    const glkernel::noise::gradient_context & context
+    , const T s
+    , const T t
+    , const unsigned int r
+    , const unsigned int components
+    , T * const noise
+    , const size_t stride)
+{
+    const T skew_constant = static_cast<T>(0.36602540378443864676); // (sqrt(3) - 1) / 2
+    const T unskew_constant = static_cast<T>(0.21132486540518711775); // (3 - sqrt(3)) / 6
+    // scale according to frequency
+    const T scaled_s = s * static_cast<T>(1 << r);
+    const T scaled_t = t * static_cast<T>(1 << r);
+    // skew the input space to determine the simplex cell origin
+    const T skew_factor = (scaled_s + scaled_t) * skew_constant;
+    const auto is = static_cast<unsigned int>(std::floor(scaled_s + skew_factor));
+    const auto it = static_cast<unsigned int>(std::floor(scaled_t + skew_factor));
+    // unskew the cell origin back to (s,t) space
+    const T unskew_factor = (is + it) * unskew_constant;
+    const T s0 = scaled_s + unskew_factor - is;
+    const T t0 = scaled_t + unskew_factor - it;
+    // lower or upper triangle of the skewed cell
+    const auto offset_s = static_cast<unsigned int>(s0 > t0);
+    const auto offset_t = 1u - offset_s;
+    // corner offsets in (s,t) space
+    const T s1 = s0 - offset_s + unskew_constant;
+    const T t1 = t0 - offset_t + unskew_constant;
+    const T s2 = s0 - 1 + 2 * unskew_constant;
+    const T t2 = t0 - 1 + 2 * unskew_constant;
+    // contribution factors
+    const T c0 = glm::max(static_cast<T>(0.5) - s0 * s0 - t0 * t0, static_cast<T>(0));
+    const T c1 = glm::max(static_cast<T>(0.5) - s1 * s1 - t1 * t1, static_cast<T>(0));
+    const T c2 = glm::max(static_cast<T>(0.5) - s2 * s2 - t2 * t2, static_cast<T>(0));
+    // Calculate the contribution from the three corners
+    const auto h0 = context.hash(is,            it,            0, r);
+    const auto h1 = context.hash(is + offset_s, it + offset_t, 0, r);
+    const auto h2 = context.hash(is + 1,        it + 1,        0, r);
+    for (unsigned int c = 0; c < components; ++c)
+    {
+        const T n0 = (c0 * c0) * (c0 * c0) * dot_grad(context.gradient(context.component_hash(h0, c)), s0, t0);
+        const T n1 = (c1 * c1) * (c1 * c1) * dot_grad(context.gradient(context.component_hash(h1, c)), s1, t1);
+        const T n2 = (c2 * c2) * (c2 * c2) * dot_grad(context.gradient(context.component_hash(h2, c)), s2, t2);
+        // The result is scaled to stay just inside [-1,1]
+        noise[c * stride] = 70 * (n0 + n1 + n2);
+    }
+}
+
+template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr>
+T simplex2(
+    const glkernel::noise::gradient_context & context
+    , const T s
+    , const T t
+    , const unsigned int r)
+{
+    auto noise = T{ 0 };
+    simplex2(context, s, t, r, 1, &noise, 1);
+    return noise;
 }
 
 template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr>
@@ -225,21 +542,351 @@ T get_octave_type_value(const glkernel::noise::OctaveType type
     }
 }
 
-template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr>
-T get_noise_type_value(const glkernel::noise::GradientNoiseType type
-    , const T x
-    , const T y
-    , const T z
-    , const unsigned int octave)
+// adds the octave's contribution to the values of a row, the octave type being fixed per row
+template<typename T>
+void accumulate_octave(const glkernel::noise::OctaveType type
+    , const unsigned int octave
+    , const T weight
+    , const T * const noise
+    , T * const values
+    , const size_t count)
 {
     switch (type)
     {
-    case glkernel::noise::GradientNoiseType::Perlin:
-        return perlin3(x, y, z, octave);
-    case glkernel::noise::GradientNoiseType::Simplex:
-        return simplex3(x, y, z, octave);
+    case glkernel::noise::OctaveType::Standard:
+        if (octave == 0)
+            for (size_t i = 0; i < count; ++i)
+                values[i] += noise[i];
+        break;
+    case glkernel::noise::OctaveType::Cloud:
+        for (size_t i = 0; i < count; ++i)
+            values[i] += weight * noise[i];
+        break;
     default:
-        return 0;
+        for (size_t i = 0; i < count; ++i)
+            values[i] += get_octave_type_value(type, octave, noise[i], weight * noise[i]);
+        break;
+    }
+}
+
+// avalanching integer mix (lowbias32 by Chris Wellons)
+inline glm::uint32 mix32(glm::uint32 h)
+{
+    h ^= h >> 16u;
+    h *= 0x7feb352du;
+    h ^= h >> 15u;
+    h *= 0x846ca68bu;
+    h ^= h >> 16u;
+    return h;
+}
+
+inline glm::uint32 hash_cell(const glm::uint32 x, const glm::uint32 y, const glm::uint32 z, const glm::uint32 key)
+{
+    return mix32(mix32(mix32(key ^ x) ^ y) ^ z);
+}
+
+// maps the upper 24 bits of a hash to [0, 1)
+template<typename T>
+T unit_hash(const glm::uint32 h)
+{
+    return static_cast<T>(h >> 8u) * static_cast<T>(5.9604644775390625e-8); // divide by 2^24
+}
+
+// Cellular (Worley) noise for a row of samples sharing t and u, using one jittered feature point
+// per cell of a (1 << r) grid that wraps around for tileability. The features of the cells
+// neighboring the row in t and u are collected once per row and octave, column by column in s,
+// so each sample only scans the contiguous features of its 3x3x3 (3x3 for planar noise) cells.
+template<typename T>
+class cellular_row
+{
+public:
+    explicit cellular_row(unsigned int max_frequency);
+
+    // distances to the nearest (f1) and second nearest (f2) feature point, in cells
+    void operator()(const T * s, size_t count, T t, T u, unsigned int r, glm::uint32 key, T * f1, T * f2);
+
+    // planar noise (u = 0) of a depth-1 kernel, searching 3x3 cells
+    void operator()(const T * s, size_t count, T t, unsigned int r, glm::uint32 key, T * f1, T * f2);
+
+protected:
+    // features of the cells within [-1, 1 << r] in s, relative to the row's cell in t and u
+    std::vector<T> m_features;
+};
+
+
+template<typename T>
+cellular_row<T>::cellular_row(const unsigned int max_frequency)
+: m_features(((1u << max_frequency) + 2) * 9 * 3)
+{
+}
+
+template<typename T>
+void cellular_row<T>::operator()(const T * const s, const size_t count, const T t, const T u, const unsigned int r, const glm::uint32 key, T * const f1, T * const f2)
+{
+    const auto frequency = 1u << r;
+    const auto mask = frequency - 1;
+    assert(m_features.size() >= (frequency + 2) * 9 * 3);
+
+    const auto scaled_t = t * static_cast<T>(frequency);
+    const auto scaled_u = u * static_cast<T>(frequency);
+
+    const auto it = static_cast<unsigned int>(std::floor(scaled_t));
+    const auto iu = static_cast<unsigned int>(std::floor(scaled_u));
+
+    const auto ft = scaled_t - std::floor(scaled_t);
+    const auto fu = scaled_u - std::floor(scaled_u);
+
+    auto feature = m_features.data();
+    for (unsigned int c = 0; c < frequency + 2; ++c)
+    {
+        for (unsigned int dt = 0; dt < 3; ++dt)
+        {
+            for (unsigned int du = 0; du < 3; ++du)
+            {
+                // cell c - 1 in s, it + dt - 1 in t, and iu + du - 1 in u, wrapped around
+                auto h = hash_cell((c + mask) & mask, (it + dt + mask) & mask, (iu + du + mask) & mask, key);
+
+                *feature++ = static_cast<T>(c) - 1 + unit_hash<T>(h);
+                h = mix32(h);
+                *feature++ = static_cast<T>(dt) - 1 + unit_hash<T>(h);
+                h = mix32(h);
+                *feature++ = static_cast<T>(du) - 1 + unit_hash<T>(h);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto scaled_s = s[i] * static_cast<T>(frequency);
+        const auto is = static_cast<unsigned int>(scaled_s);
+
+        // the 27 features of the columns is - 1, is, and is + 1 are contiguous
+        const auto features = m_features.data() + is * 9 * 3;
+
+        auto d1 = std::numeric_limits<T>::max();
+        auto d2 = std::numeric_limits<T>::max();
+        for (unsigned int k = 0; k < 27 * 3; k += 3)
+        {
+            const auto ds = features[k + 0] - scaled_s;
+            const auto dt = features[k + 1] - ft;
+            const auto du = features[k + 2] - fu;
+            const auto d = ds * ds + dt * dt + du * du;
+
+            d2 = std::min(d2, std::max(d1, d));
+            d1 = std::min(d1, d);
+        }
+
+        f1[i] = std::sqrt(d1);
+        f2[i] = std::sqrt(d2);
+    }
+}
+
+template<typename T>
+void cellular_row<T>::operator()(const T * const s, const size_t count, const T t, const unsigned int r, const glm::uint32 key, T * const f1, T * const f2)
+{
+    const auto frequency = 1u << r;
+    const auto mask = frequency - 1;
+    assert(m_features.size() >= (frequency + 2) * 3 * 2);
+
+    const auto scaled_t = t * static_cast<T>(frequency);
+    const auto it = static_cast<unsigned int>(std::floor(scaled_t));
+    const auto ft = scaled_t - std::floor(scaled_t);
+
+    auto feature = m_features.data();
+    for (unsigned int c = 0; c < frequency + 2; ++c)
+    {
+        for (unsigned int dt = 0; dt < 3; ++dt)
+        {
+            auto h = hash_cell((c + mask) & mask, (it + dt + mask) & mask, 0, key);
+
+            *feature++ = static_cast<T>(c) - 1 + unit_hash<T>(h);
+            h = mix32(h);
+            *feature++ = static_cast<T>(dt) - 1 + unit_hash<T>(h);
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto scaled_s = s[i] * static_cast<T>(frequency);
+        const auto is = static_cast<unsigned int>(scaled_s);
+
+        // the 9 features of the columns is - 1, is, and is + 1 are contiguous
+        const auto features = m_features.data() + is * 3 * 2;
+
+        auto d1 = std::numeric_limits<T>::max();
+        auto d2 = std::numeric_limits<T>::max();
+        for (unsigned int k = 0; k < 9 * 2; k += 2)
+        {
+            const auto ds = features[k + 0] - scaled_s;
+            const auto dt = features[k + 1] - ft;
+            const auto d = ds * ds + dt * dt;
+
+            d2 = std::min(d2, std::max(d1, d));
+            d1 = std::min(d1, d);
+        }
+
+        f1[i] = std::sqrt(d1);
+        f2[i] = std::sqrt(d2);
+    }
+}
+
+
+// Inverse DFT (without normalization) of a fixed length by recursive mixed-radix Cooley-Tukey,
+// i.e., O(n * sum of the length's prime factors), using precomputed twiddle factors
+template<typename T>
+class inverse_fft
+{
+public:
+    explicit inverse_fft(size_t size);
+
+    size_t scratch_size() const;
+
+    // transforms the values data[0], data[stride], ..., in place
+    void operator()(std::complex<T> * data, size_t stride, std::complex<T> * scratch) const;
+
+protected:
+    void transform(const std::complex<T> * in, size_t in_stride, std::complex<T> * out, size_t n, size_t factor, std::complex<T> * temp) const;
+
+    size_t m_size;
+    std::vector<size_t> m_factors;
+
+    // exp(2 pi i k / size)
+    std::vector<std::complex<T>> m_twiddles;
+};
+
+
+template<typename T>
+inverse_fft<T>::inverse_fft(const size_t size)
+: m_size{ size }
+, m_twiddles(size)
+{
+    auto n = size;
+    for (size_t p = 2; p * p <= n; ++p)
+    {
+        while (n % p == 0)
+        {
+            m_factors.push_back(p);
+            n /= p;
+        }
+    }
+    if (n > 1)
+        m_factors.push_back(n);
+
+    for (size_t k = 0; k < size; ++k)
+    {
+        const auto angle = 2.0 * 3.14159265358979323846 * static_cast<double>(k) / static_cast<double>(size);
+        m_twiddles[k] = std::complex<T>(static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle)));
+    }
+}
+
+template<typename T>
+size_t inverse_fft<T>::scratch_size() const
+{
+    // input copy, output, and butterfly values of the largest factor
+    return 2 * m_size + (m_factors.empty() ? 0 : m_factors.back());
+}
+
+template<typename T>
+void inverse_fft<T>::operator()(std::complex<T> * const data, const size_t stride, std::complex<T> * const scratch) const
+{
+    const auto in = scratch;
+    const auto out = scratch + m_size;
+
+    for (size_t i = 0; i < m_size; ++i)
+        in[i] = data[i * stride];
+
+    transform(in, 1, out, m_size, 0, out + m_size);
+
+    for (size_t i = 0; i < m_size; ++i)
+        data[i * stride] = out[i];
+}
+
+template<typename T>
+void inverse_fft<T>::transform(const std::complex<T> * const in, const size_t in_stride, std::complex<T> * const out
+    , const size_t n, const size_t factor, std::complex<T> * const temp) const
+{
+    if (n == 1)
+    {
+        out[0] = in[0];
+        return;
+    }
+
+    // transform the p interleaved subsequences of length m into consecutive blocks of out
+    const auto p = m_factors[factor];
+    const auto m = n / p;
+    for (size_t q = 0; q < p; ++q)
+        transform(in + q * in_stride, in_stride * p, out + q * m, m, factor + 1, temp);
+
+    // combine them: out[k + j m] = sum_q w_n^(q (k + j m)) out[q m + k], with w_n = w_size^(size / n)
+    const auto step = m_size / n;
+    if (p == 2)
+    {
+        for (size_t k = 0; k < m; ++k)
+        {
+            const auto a = out[k];
+            const auto b = out[k + m] * m_twiddles[k * step];
+            out[k] = a + b;
+            out[k + m] = a - b;
+        }
+        return;
+    }
+
+    for (size_t k = 0; k < m; ++k)
+    {
+        for (size_t j = 0; j < p; ++j)
+        {
+            auto sum = out[k];
+            for (size_t q = 1; q < p; ++q)
+                sum += out[q * m + k] * m_twiddles[(q * (k + j * m) * step) % m_size];
+            temp[j] = sum;
+        }
+        for (size_t j = 0; j < p; ++j)
+            out[k + j * m] = temp[j];
+    }
+}
+
+// frequency of the i-th DFT coefficient, those above the Nyquist frequency alias negative ones
+template<typename T>
+T signed_frequency(const glm::uint32 i, const glm::uint32 n)
+{
+    return 2 * static_cast<glm::uint64>(i) > n ? -static_cast<T>(n - i) : static_cast<T>(i);
+}
+
+// in place inverse DFT of a 3D array stored in x, y, z order, transforming the lines along each axis in parallel
+template<typename T>
+void inverse_fft3(std::complex<T> * const data, const glm::u32vec3 & extent)
+{
+    const auto size = static_cast<size_t>(extent.x) * extent.y * extent.z;
+
+    for (glm::length_t axis = 0; axis < 3; ++axis)
+    {
+        const auto n = extent[axis];
+        if (n < 2)
+            continue;
+
+        const auto fft = inverse_fft<T>{ n };
+        const auto stride = axis == 0 ? size_t{ 1 } : axis == 1 ? static_cast<size_t>(extent.x) : static_cast<size_t>(extent.x) * extent.y;
+        const auto num_lines = static_cast<long long>(size / n);
+
+        #pragma omp parallel
+        {
+            std::vector<std::complex<T>> scratch(fft.scratch_size());
+
+            #pragma omp for
+            for (long long line = 0; line < num_lines; ++line)
+            {
+                const auto l = static_cast<size_t>(line);
+
+                // index of the line's first value
+                auto first = l;
+                if (axis == 0)
+                    first = l * n;
+                else if (axis == 1)
+                    first = l % extent.x + l / extent.x * extent.x * extent.y;
+
+                fft(data + first, stride, scratch.data());
+            }
+        }
     }
 }
 
@@ -255,65 +902,149 @@ namespace noise
 {
 
 
+inline gradient_context::gradient_context()
+: m_bits{ 8 }
+, m_mask{ 255 }
+, m_permutation(std::begin(perm), std::end(perm))
+, m_gradients(256)
+{
+    // improved noise selects the gradient by the lower bits of the hash
+    for (glm::uint32 i = 0; i < 256; ++i)
+        m_gradients[i] = static_cast<unsigned char>(i & 15);
+}
+
+inline gradient_context::gradient_context(const random::seed_type seed, const unsigned int bits)
+: m_bits{ bits }
+, m_mask{ (1u << bits) - 1 }
+, m_permutation(1u << bits)
+, m_gradients(1u << bits)
+{
+    assert(bits <= s_max_bits);
+
+    auto engine = random::philox_engine{ seed };
+
+    for (glm::uint32 i = 0; i <= m_mask; ++i)
+        m_permutation[i] = static_cast<glm::uint16>(i);
+    random::shuffle(m_permutation.begin(), m_permutation.end(), engine);
+
+    for (auto & gradient : m_gradients)
+        gradient = static_cast<unsigned char>(engine() & 15);
+}
+
+inline const gradient_context & gradient_context::standard()
+{
+    static const gradient_context context;
+    return context;
+}
+
+inline const gradient_context & gradient_context::cached(const random::seed_type seed, const unsigned int bits)
+{
+    static std::mutex mutex;
+    static std::map<std::pair<random::seed_type, unsigned int>, std::unique_ptr<const gradient_context>> contexts;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto & context = contexts[std::make_pair(seed, bits)];
+    if (!context)
+        context.reset(new gradient_context{ seed, bits });
+    return *context;
+}
+
+inline unsigned int gradient_context::bits() const
+{
+    return m_bits;
+}
+
+inline glm::uint32 gradient_context::hash(const glm::uint32 x, const glm::uint32 y, const glm::uint32 z, const unsigned int r) const
+{
+    // the values of x, y and z will be in [0, 1 << r]
+    // the frequency mask is used for returning equal values
+    // for the minimum and the maximum input to ensure tileability
+    const auto frequencyMask = (1u << r) - 1;
+    assert(r <= m_bits);
+
+    const auto p = m_permutation.data();
+    return p[(p[(p[x & frequencyMask] + y) & frequencyMask] + z) & frequencyMask];
+}
+
+inline glm::uint32 gradient_context::component_hash(const glm::uint32 hash, const unsigned int component) const
+{
+    const auto other = static_cast<glm::uint32>(m_permutation[(hash + component) & m_mask]);
+    return component == 0 ? hash : other;
+}
+
+inline unsigned char gradient_context::gradient(const glm::uint32 hash) const
+{
+    return m_gradients[hash];
+}
+
+
 template <typename T>
 class uniform_operator
 {
 public:
     template<typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
-    uniform_operator(size_t size, glm::length_t
-        , T range_min, T range_max);
+    uniform_operator(size_t size, glm::length_t coefficient
+        , T range_min, T range_max, random::seed_type seed);
 
     template<typename V, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
     uniform_operator(size_t size, glm::length_t coefficient
-        , const V & range_min, const V & range_max);
+        , const V & range_min, const V & range_max, random::seed_type seed);
 
     T operator()(const size_t index);
 
 protected:
-    std::mt19937_64 m_generator;
-    std::uniform_real_distribution<T> m_distribute;
+    random::seed_type m_seed;
+    glm::length_t m_coefficient;
+
+    T m_range_min;
+    T m_range_max;
 };
 
 
 template<typename T>
 template<typename std::enable_if<std::is_floating_point<T>::value>::type *>
-uniform_operator<T>::uniform_operator(const size_t, const glm::length_t
-    , const T range_min, const T range_max)
-: m_generator{ std::random_device{ }() }
-, m_distribute{ range_min, range_max }
+uniform_operator<T>::uniform_operator(const size_t, const glm::length_t coefficient
+    , const T range_min, const T range_max, const random::seed_type seed)
+: m_seed{ seed }
+, m_coefficient{ coefficient }
+, m_range_min{ range_min }
+, m_range_max{ range_max }
 {
 }
 
 template <typename T>
 template<typename V, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type *>
 uniform_operator<T>::uniform_operator(const size_t size, const glm::length_t coefficient
-    , const V & range_min, const V & range_max)
-: uniform_operator{ size, coefficient, range_min[coefficient], range_max[coefficient] }
+    , const V & range_min, const V & range_max, const random::seed_type seed)
+: uniform_operator{ size, coefficient, range_min[coefficient], range_max[coefficient], seed }
 {
 }
 
 template<typename T>
-T uniform_operator<T>::operator()(const size_t)
+T uniform_operator<T>::operator()(const size_t index)
 {
-    return m_distribute(m_generator);
+    // every coefficient of every element uses its own counter
+    auto generator = random::philox_engine{ m_seed, index, static_cast<glm::uint32>(m_coefficient) };
+    return random::uniform(generator, m_range_min, m_range_max);
 }
 
-template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type *>
-void uniform(tkernel<T> & kernel, const T range_min, const T range_max)
+template<typename T, typename Layout, typename std::enable_if<std::is_floating_point<T>::value>::type *>
+void uniform(tkernel<T, Layout> & kernel, const T range_min, const T range_max, const random::seed_type seed)
 {
-    kernel.template for_each<uniform_operator<T>>(range_min, range_max);
+    kernel.template for_each<uniform_operator<T>>(range_min, range_max, seed);
 }
 
-template<typename V, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type *>
-void uniform(tkernel<V> & kernel, const typename V::value_type range_min, const typename V::value_type range_max)
+template<typename V, typename Layout, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type *>
+void uniform(tkernel<V, Layout> & kernel, const typename V::value_type range_min, const typename V::value_type range_max, const random::seed_type seed)
 {
-    kernel.template for_each<uniform_operator<typename V::value_type>>(range_min, range_max);
+    kernel.template for_each<uniform_operator<typename V::value_type>>(range_min, range_max, seed);
 }
 
-template <typename V, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type *>
-void uniform(tkernel<V> & kernel, const V & range_min, const V & range_max)
+template <typename V, typename Layout, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type *>
+void uniform(tkernel<V, Layout> & kernel, const V & range_min, const V & range_max, const random::seed_type seed)
 {
-    kernel.template for_each<uniform_operator<typename V::value_type>>(range_min, range_max);
+    kernel.template for_each<uniform_operator<typename V::value_type>>(range_min, range_max, seed);
 }
 
 
@@ -322,72 +1053,215 @@ class normal_operator
 {
 public:
     template <typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
-    normal_operator(size_t size, glm::length_t
-        , T mean, T stddev);
+    normal_operator(size_t size, glm::length_t coefficient
+        , T mean, T stddev, random::seed_type seed);
 
     template <typename V, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
     normal_operator(size_t size, glm::length_t coefficient
-        , const V & mean, const V & stddev);
+        , const V & mean, const V & stddev, random::seed_type seed);
 
     T operator()(const size_t index);
 
 protected:
-    std::mt19937_64 m_generator;
-    std::uniform_real_distribution<T> m_distribute;
+    random::seed_type m_seed;
+    glm::length_t m_coefficient;
+
+    T m_mean;
+    T m_stddev;
 };
 
 
 template <typename T>
 template <typename std::enable_if<std::is_floating_point<T>::value>::type *>
-normal_operator<T>::normal_operator(const size_t, const glm::length_t
-    , const T mean, const T stddev)
-: m_generator{ std::random_device{}() }
-, m_distribute{ mean, stddev }
+normal_operator<T>::normal_operator(const size_t, const glm::length_t coefficient
+    , const T mean, const T stddev, const random::seed_type seed)
+: m_seed{ seed }
+, m_coefficient{ coefficient }
+, m_mean{ mean }
+, m_stddev{ stddev }
 {
 }
 
 template <typename T>
 template <typename V, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type *>
 normal_operator<T>::normal_operator(const size_t size, const glm::length_t coefficient
-    , const V & mean, const V & stddev)
-: normal_operator{ size, coefficient, mean[coefficient], stddev[coefficient] }
+    , const V & mean, const V & stddev, const random::seed_type seed)
+: normal_operator{ size, coefficient, mean[coefficient], stddev[coefficient], seed }
 {
 }
 
 template<typename T>
-T normal_operator<T>::operator()(const size_t)
+T normal_operator<T>::operator()(const size_t index)
 {
-    return m_distribute(m_generator);
+    // every coefficient of every element uses its own counter
+    auto generator = random::philox_engine{ m_seed, index, static_cast<glm::uint32>(m_coefficient) };
+    return random::normal(generator, m_mean, m_stddev);
 }
 
-template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type *>
-void normal(tkernel<T> & kernel, const T mean, const T stddev)
+template<typename T, typename Layout, typename std::enable_if<std::is_floating_point<T>::value>::type *>
+void normal(tkernel<T, Layout> & kernel, const T mean, const T stddev, const random::seed_type seed)
 {
-    kernel.template for_each<normal_operator<T>>(mean, stddev);
+    kernel.template for_each<normal_operator<T>>(mean, stddev, seed);
 }
 
-template <typename V, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type *>
-void normal(tkernel<V> & kernel, const typename V::value_type mean, const typename V::value_type stddev)
+template <typename V, typename Layout, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type *>
+void normal(tkernel<V, Layout> & kernel, const typename V::value_type mean, const typename V::value_type stddev, const random::seed_type seed)
 {
-    kernel.template for_each<normal_operator<typename V::value_type>>(mean, stddev);
+    kernel.template for_each<normal_operator<typename V::value_type>>(mean, stddev, seed);
 }
 
-template <typename V, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type *>
-void normal(tkernel<V> & kernel, const V & mean, const V & stddev)
+template <typename V, typename Layout, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type *>
+void normal(tkernel<V, Layout> & kernel, const V & mean, const V & stddev, const random::seed_type seed)
+{
+    kernel.template for_each<normal_operator<typename V::value_type>>(mean, stddev, seed);
+}
+
+template<typename T, typename Layout>
+void gradient_brick(tkernel<T, Layout> & brick
+    , const glm::u32vec3 & offset
+    , const glm::u32vec3 & extent
+    , const GradientNoiseType noise_type
+    , const OctaveType octave_type
+    , const unsigned int start_frequency
+    , const unsigned int octaves
+    , const gradient_context & context
+    , const bool parallel)
 {
-    kernel.template for_each<normal_operator<typename V::value_type>>(mean, stddev);
+    if (brick.size() < 1)
+        return;
+
+    std::vector<T> fo(octaves);
+
+    for (unsigned int o = 0; o < octaves; ++o)
+    {
+        fo[o] = static_cast<T>(1.0 / (1 << o));
+    }
+
+    // the brick is generated row by row, with positions along a row shared by all rows
+    const auto width = brick.width();
+    const auto height = brick.height();
+
+    std::vector<T> s(width);
+    for (glm::uint32 i = 0; i < width; ++i)
+        s[i] = static_cast<T>(offset.x + i) / extent.x;
+
+    const auto num_rows = static_cast<long long>(height) * brick.depth();
+    const auto max_frequency = octaves > 0 ? start_frequency + octaves - 1 : 0;
+
+    // flat volumes use 2D noise
+    const auto planar = extent.z == 1;
+
+    #pragma omp parallel if(parallel)
+    {
+        auto perlin = perlin_row<T>{ context, max_frequency };
+
+        std::vector<T> noise(width);
+        std::vector<T> values(width);
+
+        #pragma omp for
+        for (long long row = 0; row < num_rows; ++row)
+        {
+            const auto t_index = static_cast<glm::uint32>(row % height);
+            const auto u_index = static_cast<glm::uint32>(row / height);
+
+            const auto t = static_cast<T>(offset.y + t_index) / extent.y;
+            const auto u = static_cast<T>(offset.z + u_index) / extent.z;
+
+            // collect noise values over multiple octaves
+            std::fill(values.begin(), values.end(), static_cast<T>(0.5));
+            for (unsigned int o = 0; o < octaves; ++o)
+            {
+                switch (noise_type)
+                {
+                case GradientNoiseType::Perlin:
+                    if (planar)
+                        perlin(s.data(), width, t, o + start_frequency, noise.data());
+                    else
+                        perlin(s.data(), width, t, u, o + start_frequency, noise.data());
+                    break;
+                case GradientNoiseType::Simplex:
+                    if (planar)
+                        for (glm::uint32 i = 0; i < width; ++i)
+                            noise[i] = simplex2(context, s[i], t, o + start_frequency);
+                    else
+                        for (glm::uint32 i = 0; i < width; ++i)
+                            noise[i] = simplex3(context, s[i], t, u, o + start_frequency);
+                    break;
+                default:
+                    std::fill(noise.begin(), noise.end(), static_cast<T>(0));
+                    break;
+                }
+
+                accumulate_octave(octave_type, o, fo[o], noise.data(), values.data(), width);
+            }
+
+            const auto first = brick.index(0, t_index, u_index);
+            for (glm::uint32 i = 0; i < width; ++i)
+                brick[first + i] = values[i];
+        }
+    }
 }
 
-template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type *>
-void gradient(tkernel<T> & kernel
+template<typename T, typename Layout, typename std::enable_if<std::is_floating_point<T>::value>::type *>
+void gradient(tkernel<T, Layout> & kernel
     , const GradientNoiseType noise_type
     , const OctaveType octave_type
     , const unsigned int start_frequency
-    , const unsigned int octaves)
+    , const unsigned int octaves
+    , const gradient_context & context)
 {
+    gradient_brick(kernel, glm::u32vec3(0), kernel.extent(), noise_type, octave_type, start_frequency, octaves, context, true);
+}
+
+template<typename T, typename Sink, typename std::enable_if<std::is_floating_point<T>::value>::type *>
+void gradient(const glm::u32vec3 & extent
+    , const glm::u32vec3 & brick_extent
+    , Sink && sink
+    , const GradientNoiseType noise_type
+    , const OctaveType octave_type
+    , const unsigned int start_frequency
+    , const unsigned int octaves
+    , const gradient_context & context)
+{
+    assert(brick_extent.x > 0 && brick_extent.y > 0 && brick_extent.z > 0);
+
+    const auto num_bricks = (extent + brick_extent - 1u) / brick_extent;
+    const auto count = static_cast<long long>(num_bricks.x) * num_bricks.y * num_bricks.z;
+
+    // bricks are generated in parallel (one per thread), handing them to the sink one at a time
+    #pragma omp parallel for schedule(dynamic)
+    for (long long b = 0; b < count; ++b)
+    {
+        const auto index = static_cast<glm::uint64>(b);
+        const auto offset = glm::u32vec3(
+            static_cast<glm::uint32>(index % num_bricks.x),
+            static_cast<glm::uint32>(index / num_bricks.x % num_bricks.y),
+            static_cast<glm::uint32>(index / num_bricks.x / num_bricks.y)) * brick_extent;
+
+        auto brick = tkernel<T>{ glm::min(brick_extent, extent - offset) };
+        gradient_brick(brick, offset, extent, noise_type, octave_type, start_frequency, octaves, context, false);
+
+        #pragma omp critical(glkernel_noise_brick_sink)
+        sink(static_cast<const tkernel<T> &>(brick), static_cast<const glm::u32vec3 &>(offset));
+    }
+}
+
+
+template<typename V, typename Layout, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type *>
+void gradient(tkernel<V, Layout> & kernel
+    , const GradientNoiseType noise_type
+    , const OctaveType octave_type
+    , const unsigned int start_frequency
+    , const unsigned int octaves
+    , const gradient_context & context)
+{
+    using T = typename V::value_type;
+
     if (kernel.size() < 1)
         return;
 
+    const auto components = static_cast<unsigned int>(tkernel<V, Layout>::length());
+
     std::vector<T> fo(octaves);
 
     for (unsigned int o = 0; o < octaves; ++o)
@@ -395,25 +1269,468 @@ void gradient(tkernel<T> & kernel
         fo[o] = static_cast<T>(1.0 / (1 << o));
     }
 
-    #pragma omp parallel for
-    for (long long i = 0; i < static_cast<long long>(kernel.size()); ++i)
+    const auto width = kernel.width();
+    const auto height = kernel.height();
+
+    std::vector<T> s(width);
+    for (glm::uint32 i = 0; i < width; ++i)
+        s[i] = static_cast<T>(i) / width;
+
+    const auto num_rows = static_cast<long long>(height) * kernel.depth();
+    const auto max_frequency = octaves > 0 ? start_frequency + octaves - 1 : 0;
+
+    // flat kernels use 2D noise
+    const auto planar = kernel.depth() == 1;
+
+    #pragma omp parallel
     {
-        const auto location = static_cast<glm::tvec3<T, glm::highp>>(kernel.position(i));
-        const auto x = location.x / kernel.width();
-        const auto y = location.y / kernel.height();
-        const auto z = location.z / kernel.depth();
+        auto perlin = perlin_row<T>{ context, max_frequency, components };
+
+        // component c of the row is stored at c * width
+        std::vector<T> noise(width * components);
+        std::vector<T> values(width * components);
 
-        // collect noise values over multiple octaves
-        T p = 0.5;
-        for (unsigned int o = 0; o < octaves; ++o)
+        #pragma omp for
+        for (long long row = 0; row < num_rows; ++row)
         {
-            const T po = get_noise_type_value(noise_type, x, y, z, o + start_frequency);
-            const T pf = fo[o] * po;
+            const auto t_index = static_cast<glm::uint32>(row % height);
+            const auto u_index = static_cast<glm::uint32>(row / height);
+
+            const auto t = static_cast<T>(t_index) / height;
+            const auto u = static_cast<T>(u_index) / kernel.depth();
+
+            // collect noise values over multiple octaves
+            std::fill(values.begin(), values.end(), static_cast<T>(0.5));
+            for (unsigned int o = 0; o < octaves; ++o)
+            {
+                const auto r = o + start_frequency;
+
+                switch (noise_type)
+                {
+                case GradientNoiseType::Perlin:
+                    if (planar)
+                        perlin(s.data(), width, t, r, components, noise.data());
+                    else
+                        perlin(s.data(), width, t, u, r, components, noise.data());
+                    break;
+                case GradientNoiseType::Simplex:
+                    // the components only differ in their corner gradients
+                    if (planar)
+                        for (glm::uint32 i = 0; i < width; ++i)
+                            simplex2(context, s[i], t, r, components, noise.data() + i, width);
+                    else
+                        for (glm::uint32 i = 0; i < width; ++i)
+                            simplex3(context, s[i], t, u, r, components, noise.data() + i, width);
+                    break;
+                default:
+                    std::fill(noise.begin(), noise.end(), static_cast<T>(0));
+                    break;
+                }
+
+                accumulate_octave(octave_type, o, fo[o], noise.data(), values.data(), noise.size());
+            }
+
+            const auto first = kernel.index(0, t_index, u_index);
+            for (glm::uint32 i = 0; i < width; ++i)
+            {
+                auto value = V{};
+                for (unsigned int c = 0; c < components; ++c)
+                    value[static_cast<glm::length_t>(c)] = values[c * width + i];
+                kernel[first + i] = value;
+            }
+        }
+    }
+}
 
-            p += get_octave_type_value(octave_type, o, po, pf);
+// rows of curl noise: the derivatives of the potential's components (sum over octaves) are handed to the store
+template<typename T, typename Kernel, typename Store>
+void curl_rows(Kernel & kernel
+    , const unsigned int components
+    , const bool planar
+    , const unsigned int start_frequency
+    , const unsigned int octaves
+    , const gradient_context & context
+    , Store store)
+{
+    if (kernel.size() < 1)
+        return;
+
+    const auto width = kernel.width();
+    const auto height = kernel.height();
+
+    std::vector<T> s(width);
+    for (glm::uint32 i = 0; i < width; ++i)
+        s[i] = static_cast<T>(i) / width;
+
+    const auto num_rows = static_cast<long long>(height) * kernel.depth();
+    const auto max_frequency = octaves > 0 ? start_frequency + octaves - 1 : 0;
+
+    #pragma omp parallel
+    {
+        auto perlin = perlin_row<T>{ context, max_frequency, components };
+
+        std::vector<T> noise(width * components);
+        std::vector<T> ds(width * components);
+        std::vector<T> dt(width * components);
+        std::vector<T> du(width * components);
+
+        std::vector<T> sum_ds(width * components);
+        std::vector<T> sum_dt(width * components);
+        std::vector<T> sum_du(width * components);
+
+        #pragma omp for
+        for (long long row = 0; row < num_rows; ++row)
+        {
+            const auto t_index = static_cast<glm::uint32>(row % height);
+            const auto u_index = static_cast<glm::uint32>(row / height);
+
+            const auto t = static_cast<T>(t_index) / height;
+            const auto u = static_cast<T>(u_index) / kernel.depth();
+
+            std::fill(sum_ds.begin(), sum_ds.end(), static_cast<T>(0));
+            std::fill(sum_dt.begin(), sum_dt.end(), static_cast<T>(0));
+            std::fill(sum_du.begin(), sum_du.end(), static_cast<T>(0));
+            for (unsigned int o = 0; o < octaves; ++o)
+            {
+                // the derivatives per cell of octave o equal those of 2^-o * noise(2^o * x) per cell of the start frequency
+                if (planar)
+                    perlin(s.data(), width, t, o + start_frequency, components, noise.data(), ds.data(), dt.data());
+                else
+                    perlin(s.data(), width, t, u, o + start_frequency, components, noise.data(), ds.data(), dt.data(), du.data());
+
+                for (size_t i = 0; i < sum_ds.size(); ++i)
+                {
+                    sum_ds[i] += ds[i];
+                    sum_dt[i] += dt[i];
+                }
+                if (!planar)
+                    for (size_t i = 0; i < sum_du.size(); ++i)
+                        sum_du[i] += du[i];
+            }
+
+            store(kernel.index(0, t_index, u_index), sum_ds.data(), sum_dt.data(), sum_du.data(), width);
+        }
+    }
+}
+
+template<typename T, glm::precision P, typename Layout>
+void curl(tkernel<glm::tvec2<T, P>, Layout> & kernel
+    , const unsigned int start_frequency
+    , const unsigned int octaves
+    , const gradient_context & context)
+{
+    curl_rows<T>(kernel, 1, kernel.depth() == 1, start_frequency, octaves, context
+        , [&kernel](const size_t first, const T * const ds, const T * const dt, const T *, const glm::uint32 count)
+    {
+        for (glm::uint32 i = 0; i < count; ++i)
+            kernel[first + i] = glm::tvec2<T, P>(dt[i], -ds[i]);
+    });
+}
+
+template<typename T, glm::precision P, typename Layout>
+void curl(tkernel<glm::tvec3<T, P>, Layout> & kernel
+    , const unsigned int start_frequency
+    , const unsigned int octaves
+    , const gradient_context & context)
+{
+    curl_rows<T>(kernel, 3, false, start_frequency, octaves, context
+        , [&kernel](const size_t first, const T * const ds, const T * const dt, const T * const du, const glm::uint32 count)
+    {
+        // derivatives of the potential's component c are stored at c * count
+        const auto x = 0 * count;
+        const auto y = 1 * count;
+        const auto z = 2 * count;
+
+        for (glm::uint32 i = 0; i < count; ++i)
+        {
+            kernel[first + i] = glm::tvec3<T, P>(
+                dt[z + i] - du[y + i],
+                du[x + i] - ds[z + i],
+                ds[y + i] - dt[x + i]);
+        }
+    });
+}
+
+
+template<typename T, typename Kernel, typename Store>
+void cellular_rows(Kernel & kernel
+    , const CellularNoiseType noise_type
+    , const OctaveType octave_type
+    , const unsigned int start_frequency
+    , const unsigned int octaves
+    , const random::seed_type seed
+    , const bool pairs
+    , Store store)
+{
+    if (kernel.size() < 1)
+        return;
+
+    std::vector<T> fo(octaves);
+    std::vector<glm::uint32> keys(octaves);
+
+    for (unsigned int o = 0; o < octaves; ++o)
+    {
+        fo[o] = static_cast<T>(1.0 / (1 << o));
+        // every octave uses its own feature points
+        keys[o] = random::philox_engine{ seed, o, 0 }();
+    }
+
+    const auto width = kernel.width();
+    const auto height = kernel.height();
+
+    std::vector<T> s(width);
+    for (glm::uint32 i = 0; i < width; ++i)
+        s[i] = static_cast<T>(i) / width;
+
+    const auto num_rows = static_cast<long long>(height) * kernel.depth();
+    const auto max_frequency = octaves > 0 ? start_frequency + octaves - 1 : 0;
+
+    // flat kernels use 2D noise
+    const auto planar = kernel.depth() == 1;
+
+    #pragma omp parallel
+    {
+        auto cellular = cellular_row<T>{ max_frequency };
+
+        std::vector<T> f1(width);
+        std::vector<T> f2(width);
+        std::vector<T> noise(width);
+        std::vector<T> values(width);
+        std::vector<T> seconds(pairs ? width : 0);
+
+        #pragma omp for
+        for (long long row = 0; row < num_rows; ++row)
+        {
+            const auto t_index = static_cast<glm::uint32>(row % height);
+            const auto u_index = static_cast<glm::uint32>(row / height);
+
+            const auto t = static_cast<T>(t_index) / height;
+            const auto u = static_cast<T>(u_index) / kernel.depth();
+
+            // collect noise values over multiple octaves
+            std::fill(values.begin(), values.end(), static_cast<T>(0));
+            std::fill(seconds.begin(), seconds.end(), static_cast<T>(0));
+            for (unsigned int o = 0; o < octaves; ++o)
+            {
+                if (planar)
+                    cellular(s.data(), width, t, o + start_frequency, keys[o], f1.data(), f2.data());
+                else
+                    cellular(s.data(), width, t, u, o + start_frequency, keys[o], f1.data(), f2.data());
+
+                switch (noise_type)
+                {
+                case CellularNoiseType::F1:
+                    std::copy(f1.begin(), f1.end(), noise.begin());
+                    break;
+                case CellularNoiseType::F2:
+                    std::copy(f2.begin(), f2.end(), noise.begin());
+                    break;
+                case CellularNoiseType::F2MinusF1:
+                    for (glm::uint32 i = 0; i < width; ++i)
+                        noise[i] = f2[i] - f1[i];
+                    break;
+                default:
+                    std::fill(noise.begin(), noise.end(), static_cast<T>(0));
+                    break;
+                }
+
+                accumulate_octave(octave_type, o, fo[o], noise.data(), values.data(), width);
+                if (pairs)
+                    accumulate_octave(octave_type, o, fo[o], f2.data(), seconds.data(), width);
+            }
+
+            store(kernel.index(0, t_index, u_index), values.data(), seconds.data(), width);
+        }
+    }
+}
+
+template<typename T, typename Layout, typename std::enable_if<std::is_floating_point<T>::value>::type *>
+void cellular(tkernel<T, Layout> & kernel
+    , const CellularNoiseType noise_type
+    , const OctaveType octave_type
+    , const unsigned int start_frequency
+    , const unsigned int octaves
+    , const random::seed_type seed)
+{
+    cellular_rows<T>(kernel, noise_type, octave_type, start_frequency, octaves, seed, false
+        , [&kernel](const size_t first, const T * const values, const T *, const glm::uint32 count)
+    {
+        for (glm::uint32 i = 0; i < count; ++i)
+            kernel[first + i] = values[i];
+    });
+}
+
+template<typename T, glm::precision P, typename Layout>
+void cellular(tkernel<glm::tvec2<T, P>, Layout> & kernel
+    , const OctaveType octave_type
+    , const unsigned int start_frequency
+    , const unsigned int octaves
+    , const random::seed_type seed)
+{
+    cellular_rows<T>(kernel, CellularNoiseType::F1, octave_type, start_frequency, octaves, seed, true
+        , [&kernel](const size_t first, const T * const f1, const T * const f2, const glm::uint32 count)
+    {
+        for (glm::uint32 i = 0; i < count; ++i)
+            kernel[first + i] = glm::tvec2<T, P>(f1[i], f2[i]);
+    });
+}
+
+
+template <typename T>
+T power_law<T>::operator()(const T frequency) const
+{
+    return std::pow(frequency, -beta);
+}
+
+template<typename T>
+power_law<T> spectral_power_law(const SpectralNoiseType noise_type)
+{
+    switch (noise_type)
+    {
+    case SpectralNoiseType::White:
+        return power_law<T>{ 0 };
+    case SpectralNoiseType::Pink:
+        return power_law<T>{ 1 };
+    case SpectralNoiseType::Brown:
+        return power_law<T>{ 2 };
+    case SpectralNoiseType::Blue:
+        return power_law<T>{ -1 };
+    case SpectralNoiseType::Violet:
+        return power_law<T>{ -2 };
+    default:
+        return power_law<T>{ 0 };
+    }
+}
+
+template<typename T, typename Kernel, typename Spectrum, typename Store>
+void spectral_fields(Kernel & kernel
+    , Spectrum & spectrum
+    , const random::seed_type seed
+    , Store store)
+{
+    if (kernel.size() < 1)
+        return;
+
+    const auto size = static_cast<long long>(kernel.size());
+    const auto extent = kernel.extent();
+
+    // circularly symmetric white noise shaped by the amplitude spectrum; as the spectrum is
+    // symmetric, real and imaginary part of its inverse DFT are independent real noise fields
+    std::vector<std::complex<T>> values(kernel.size());
+
+    #pragma omp parallel for
+    for (long long i = 0; i < size; ++i)
+    {
+        const auto index = static_cast<size_t>(i);
+        const auto position = kernel.position(index);
+
+        const auto ks = signed_frequency<T>(position.x, extent.x);
+        const auto kt = signed_frequency<T>(position.y, extent.y);
+        const auto ku = signed_frequency<T>(position.z, extent.z);
+        const auto frequency = std::sqrt(ks * ks + kt * kt + ku * ku);
+
+        // the mean (zero frequency) is removed
+        if (index == 0)
+        {
+            values[index] = std::complex<T>(0, 0);
+            continue;
         }
 
-        kernel[i] = p;
+        const auto amplitude = std::sqrt(std::max(static_cast<T>(spectrum(frequency)), static_cast<T>(0)));
+
+        auto generator = random::philox_engine{ seed, index };
+        const auto re = random::normal(generator, static_cast<T>(0), static_cast<T>(1));
+        const auto im = random::normal(generator, static_cast<T>(0), static_cast<T>(1));
+        values[index] = amplitude * std::complex<T>(re, im);
+    }
+
+    inverse_fft3(values.data(), extent);
+
+    // normalize both fields to unit standard deviation
+    auto sum_re = 0.0;
+    auto sum_im = 0.0;
+
+    #pragma omp parallel for reduction(+:sum_re,sum_im)
+    for (long long i = 0; i < size; ++i)
+    {
+        const auto & value = values[static_cast<size_t>(i)];
+        sum_re += static_cast<double>(value.real()) * value.real();
+        sum_im += static_cast<double>(value.imag()) * value.imag();
+    }
+
+    const auto scale_re = sum_re > 0.0 ? static_cast<T>(std::sqrt(static_cast<double>(size) / sum_re)) : static_cast<T>(0);
+    const auto scale_im = sum_im > 0.0 ? static_cast<T>(std::sqrt(static_cast<double>(size) / sum_im)) : static_cast<T>(0);
+
+    #pragma omp parallel for
+    for (long long i = 0; i < size; ++i)
+    {
+        const auto index = static_cast<size_t>(i);
+        store(index, values[index].real() * scale_re, values[index].imag() * scale_im);
+    }
+}
+
+template<typename T, typename Layout, typename std::enable_if<std::is_floating_point<T>::value>::type *>
+void spectral(tkernel<T, Layout> & kernel
+    , const SpectralNoiseType noise_type
+    , const random::seed_type seed)
+{
+    spectral(kernel, spectral_power_law<T>(noise_type), seed);
+}
+
+template<typename T, typename Layout, typename Spectrum, typename std::enable_if<std::is_floating_point<T>::value
+    && !std::is_same<typename std::decay<Spectrum>::type, SpectralNoiseType>::value>::type *>
+void spectral(tkernel<T, Layout> & kernel
+    , Spectrum && spectrum
+    , const random::seed_type seed)
+{
+    spectral_fields<T>(kernel, spectrum, seed, [&kernel](const size_t index, const T x, const T)
+    {
+        kernel[index] = x;
+    });
+}
+
+template<typename T, glm::precision P, typename Layout>
+void spectral(tkernel<glm::tvec2<T, P>, Layout> & kernel
+    , const SpectralNoiseType noise_type
+    , const random::seed_type seed)
+{
+    spectral(kernel, spectral_power_law<T>(noise_type), seed);
+}
+
+template<typename T, glm::precision P, typename Layout, typename Spectrum
+    , typename std::enable_if<!std::is_same<typename std::decay<Spectrum>::type, SpectralNoiseType>::value>::type *>
+void spectral(tkernel<glm::tvec2<T, P>, Layout> & kernel
+    , Spectrum && spectrum
+    , const random::seed_type seed)
+{
+    spectral_fields<T>(kernel, spectrum, seed, [&kernel](const size_t index, const T x, const T y)
+    {
+        kernel[index] = glm::tvec2<T, P>(x, y);
+    });
+}
+
+
+template <typename T>
+volume_writer<T>::volume_writer(std::ostream & stream, const glm::u32vec3 & extent)
+: m_stream(stream)
+, m_begin{ stream.tellp() }
+, m_extent{ extent }
+{
+}
+
+template <typename T>
+void volume_writer<T>::operator()(const tkernel<T> & brick, const glm::u32vec3 & offset)
+{
+    // the volume is stored in x, y, z order, so each row of a brick is contiguous
+    for (glm::uint32 r = 0; r < brick.depth(); ++r)
+    {
+        for (glm::uint32 t = 0; t < brick.height(); ++t)
+        {
+            const auto index = (static_cast<glm::uint64>(offset.z + r) * m_extent.y + offset.y + t) * m_extent.x + offset.x;
+
+            m_stream.seekp(m_begin + static_cast<std::streamoff>(index * sizeof(T)));
+            m_stream.write(reinterpret_cast<const char *>(&brick.value(0, t, r)), static_cast<std::streamsize>(brick.width() * sizeof(T)));
+        }
     }
 }
 
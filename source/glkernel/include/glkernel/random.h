@@ -0,0 +1,100 @@
+#pragma once
+
+#include <type_traits>
+
+#include <glm/gtc/type_precision.hpp>
+
+
+namespace glkernel
+{
+
+
+namespace random
+{
+
+
+/**
+*  @brief
+*    Seed type used by all stochastic functions of glkernel.
+*
+*    Given the same seed, every stochastic function generates the same
+*    kernel, independent of the number of threads used.
+*/
+using seed_type = glm::uint64;
+
+/**
+*  @brief
+*    Draws a seed from std::random_device, used as default seed for all
+*    stochastic functions (non-reproducible results).
+*/
+seed_type nondeterministic_seed();
+
+/**
+*  @brief
+*    Counter-based Philox4x32-10 bijection as described in "Parallel Random
+*    Numbers: As Easy as 1, 2, 3" by Salmon et al. in 2011.
+*
+*    The result depends on counter and key only, i.e., no state is involved.
+*/
+glm::u32vec4 philox4x32(glm::u32vec4 counter, glm::u32vec2 key);
+
+/**
+*  @brief
+*    Random number engine (UniformRandomBitGenerator) based on philox4x32.
+*
+*    The seed is used as key, the counter comprises the element index, a
+*    stream number, and the number of generated blocks. Thus, every element
+*    (and every stream of an element) can be generated independently.
+*/
+class philox_engine
+{
+public:
+    using result_type = glm::uint32;
+
+    static constexpr result_type min() { return 0u; }
+    static constexpr result_type max() { return 0xffffffffu; }
+
+    philox_engine(seed_type seed, glm::uint64 index = 0, glm::uint32 stream = 0);
+
+    result_type operator()();
+
+protected:
+    glm::u32vec2 m_key;
+    glm::u32vec4 m_counter;
+
+    glm::u32vec4 m_block;
+    glm::length_t m_consumed;
+};
+
+// uniform real number within [0, 1)
+template <typename T, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
+T uniform(philox_engine & engine);
+
+// uniform real number within [range_min, range_max)
+template <typename T, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
+T uniform(philox_engine & engine, T range_min, T range_max);
+
+// normal distributed real number (Ziggurat method)
+template <typename T, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
+T normal(philox_engine & engine, T mean, T stddev);
+
+// uniform integer within [0, range), range must be greater than zero
+glm::uint32 bounded(philox_engine & engine, glm::uint32 range);
+
+// element at position index of a pseudo-random permutation of [0, length)
+// selected by key, computed without tables (Kensler, "Correlated
+// Multi-Jittered Sampling", 2013), length must be greater than zero
+glm::uint32 permute(glm::uint32 index, glm::uint32 length, glm::uint32 key);
+
+// Fisher-Yates shuffle, replaces std::random_shuffle (removed in C++17)
+template <typename RandomIt>
+void shuffle(RandomIt first, RandomIt last, philox_engine & engine);
+
+
+} // namespace random
+
+
+} // namespace glkernel
+
+
+#include <glkernel/random.hpp>
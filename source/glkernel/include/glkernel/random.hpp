@@ -0,0 +1,259 @@
+#pragma once
+
+#include <glkernel/random.h>
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+
+#include <glm/gtc/constants.hpp>
+
+
+namespace glkernel
+{
+
+
+namespace random
+{
+
+
+inline seed_type nondeterministic_seed()
+{
+    std::random_device RD;
+    return (static_cast<seed_type>(RD()) << 32u) ^ static_cast<seed_type>(RD());
+}
+
+inline glm::u32vec4 philox4x32(glm::u32vec4 counter, glm::u32vec2 key)
+{
+    static const glm::uint64 m0 = 0xD2511F53u;
+    static const glm::uint64 m1 = 0xCD9E8D57u;
+
+    static const glm::uint32 w0 = 0x9E3779B9u;
+    static const glm::uint32 w1 = 0xBB67AE85u;
+
+    for (int round = 0; round < 10; ++round)
+    {
+        if (round > 0)
+        {
+            key.x += w0;
+            key.y += w1;
+        }
+
+        const auto p0 = m0 * counter.x;
+        const auto p1 = m1 * counter.z;
+
+        counter = glm::u32vec4{
+            static_cast<glm::uint32>(p1 >> 32u) ^ counter.y ^ key.x,
+            static_cast<glm::uint32>(p1),
+            static_cast<glm::uint32>(p0 >> 32u) ^ counter.w ^ key.y,
+            static_cast<glm::uint32>(p0) };
+    }
+
+    return counter;
+}
+
+inline philox_engine::philox_engine(const seed_type seed, const glm::uint64 index, const glm::uint32 stream)
+: m_key{ static_cast<glm::uint32>(seed), static_cast<glm::uint32>(seed >> 32u) }
+, m_counter{ static_cast<glm::uint32>(index), static_cast<glm::uint32>(index >> 32u), stream, 0u }
+, m_block{ 0u, 0u, 0u, 0u }
+, m_consumed{ 4 }
+{
+}
+
+inline philox_engine::result_type philox_engine::operator()()
+{
+    if (m_consumed == 4)
+    {
+        m_block = philox4x32(m_counter, m_key);
+        ++m_counter.w;
+
+        m_consumed = 0;
+    }
+    return m_block[m_consumed++];
+}
+
+template <typename T, typename std::enable_if<std::is_floating_point<T>::value>::type *>
+T uniform(philox_engine & engine)
+{
+    // use 53 bits for double and 24 bits for float precision, avoiding rounding up to 1
+    if (std::numeric_limits<T>::digits > 32)
+    {
+        const auto a = static_cast<glm::uint64>(engine() >> 5u);
+        const auto b = static_cast<glm::uint64>(engine() >> 6u);
+        return static_cast<T>((a << 26u) | b) * static_cast<T>(1.1102230246251565e-16); // divide by 2^53
+    }
+    return static_cast<T>(engine() >> 8u) * static_cast<T>(5.9604644775390625e-8); // divide by 2^24
+}
+
+template <typename T, typename std::enable_if<std::is_floating_point<T>::value>::type *>
+T uniform(philox_engine & engine, const T range_min, const T range_max)
+{
+    return range_min + (range_max - range_min) * uniform<T>(engine);
+}
+
+// layers of the ziggurat for the normal distribution, see "The Ziggurat Method for Generating
+// Random Variables" by Marsaglia and Tsang in 2000, using the 128 layer setup of "An Improved
+// Ziggurat Method to Generate Normal Random Samples" by Doornik in 2005
+class normal_ziggurat
+{
+public:
+    static const glm::uint32 s_layers = 128;
+
+    static const normal_ziggurat & get();
+
+    // right edges of the layers (the first being the virtual width of the base), descending to 0
+    double x[s_layers + 1];
+    // ratios of the next layer's edge to the layer's edge, i.e., the rectangular part of a layer
+    double ratio[s_layers];
+    // unnormalized density at the edges
+    double f[s_layers + 1];
+
+protected:
+    normal_ziggurat();
+};
+
+inline normal_ziggurat::normal_ziggurat()
+{
+    static const auto r = 3.442619855899;
+    static const auto v = 9.91256303526217e-3;
+
+    x[0] = v / std::exp(-0.5 * r * r);
+    x[1] = r;
+    for (glm::uint32 i = 2; i < s_layers; ++i)
+        x[i] = std::sqrt(-2.0 * std::log(v / x[i - 1] + std::exp(-0.5 * x[i - 1] * x[i - 1])));
+    x[s_layers] = 0.0;
+
+    for (glm::uint32 i = 0; i < s_layers; ++i)
+        ratio[i] = x[i + 1] / x[i];
+    for (glm::uint32 i = 0; i <= s_layers; ++i)
+        f[i] = std::exp(-0.5 * x[i] * x[i]);
+}
+
+inline const normal_ziggurat & normal_ziggurat::get()
+{
+    static const normal_ziggurat ziggurat;
+    return ziggurat;
+}
+
+template <typename T, typename std::enable_if<std::is_floating_point<T>::value>::type *>
+T normal(philox_engine & engine, const T mean, const T stddev)
+{
+    const auto & ziggurat = normal_ziggurat::get();
+
+    for (;;)
+    {
+        // 7 bits select the layer, 1 bit the sign, and for float the remaining 24 bits the position
+        const auto bits = engine();
+        const auto layer = bits & (normal_ziggurat::s_layers - 1);
+        const auto sign = static_cast<T>((bits & 0x80u) ? -1 : 1);
+
+        const auto u = std::numeric_limits<T>::digits > 24
+            ? uniform<double>(engine) : static_cast<double>(bits >> 8u) * 5.9604644775390625e-8; // divide by 2^24
+        const auto x = u * ziggurat.x[layer];
+
+        // within the rectangle covered by the next layer (about 99% of all samples)
+        if (u < ziggurat.ratio[layer])
+            return mean + stddev * sign * static_cast<T>(x);
+
+        if (layer == 0)
+        {
+            // tail beyond r (Marsaglia, 1964), u1 and u2 within (0, 1] to avoid log(0)
+            const auto r = ziggurat.x[1];
+            auto a = 0.0;
+            auto b = 0.0;
+            do
+            {
+                a = -std::log(1 - uniform<double>(engine)) / r;
+                b = -std::log(1 - uniform<double>(engine));
+            } while (b + b < a * a);
+
+            return mean + stddev * sign * static_cast<T>(r + a);
+        }
+
+        // wedge between the layer's rectangle and the density
+        const auto y = ziggurat.f[layer] + (ziggurat.f[layer + 1] - ziggurat.f[layer]) * uniform<double>(engine);
+        if (y < std::exp(-0.5 * x * x))
+            return mean + stddev * sign * static_cast<T>(x);
+    }
+}
+
+inline glm::uint32 bounded(philox_engine & engine, const glm::uint32 range)
+{
+    assert(range > 0);
+
+    // multiply-shift with rejection (Lemire, "Fast Random Integer Generation in an Interval", 2019)
+    auto m = static_cast<glm::uint64>(engine()) * range;
+    auto low = static_cast<glm::uint32>(m);
+
+    if (low < range)
+    {
+        const auto threshold = (0u - range) % range;
+        while (low < threshold)
+        {
+            m = static_cast<glm::uint64>(engine()) * range;
+            low = static_cast<glm::uint32>(m);
+        }
+    }
+    return static_cast<glm::uint32>(m >> 32u);
+}
+
+inline glm::uint32 permute(glm::uint32 index, const glm::uint32 length, const glm::uint32 key)
+{
+    assert(length > 0);
+    assert(index < length);
+
+    // smallest all-ones mask covering [0, length)
+    auto mask = length - 1;
+    mask |= mask >> 1u;
+    mask |= mask >> 2u;
+    mask |= mask >> 4u;
+    mask |= mask >> 8u;
+    mask |= mask >> 16u;
+
+    // invertible hash on the masked bits, cycle-walking until within range
+    do
+    {
+        index ^= key;
+        index *= 0xe170893du;
+        index ^= key >> 16u;
+        index ^= (index & mask) >> 4u;
+        index ^= key >> 8u;
+        index *= 0x0929eb3fu;
+        index ^= key >> 23u;
+        index ^= (index & mask) >> 1u;
+        index *= 1u | key >> 27u;
+        index *= 0x6935fa69u;
+        index ^= (index & mask) >> 11u;
+        index *= 0x74dcb303u;
+        index ^= (index & mask) >> 2u;
+        index *= 0x9e501cc3u;
+        index ^= (index & mask) >> 2u;
+        index *= 0xc860a3dfu;
+        index &= mask;
+        index ^= index >> 5u;
+    } while (index >= length);
+
+    return static_cast<glm::uint32>((static_cast<glm::uint64>(index) + key) % length);
+}
+
+template <typename RandomIt>
+void shuffle(const RandomIt first, const RandomIt last, philox_engine & engine)
+{
+    const auto size = last - first;
+
+    for (auto i = size - 1; i > 0; --i)
+    {
+        const auto j = bounded(engine, static_cast<glm::uint32>(i + 1));
+
+        using std::swap;
+        swap(first[i], first[j]);
+    }
+}
+
+
+} // namespace random
+
+
+} // namespace glkernel
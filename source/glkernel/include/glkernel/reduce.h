@@ -0,0 +1,57 @@
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include <glm/gtc/type_precision.hpp>
+
+#include <glkernel/Kernel.h>
+
+
+namespace glkernel
+{
+
+
+namespace reduce
+{
+
+
+// All reductions run in parallel over chunks of values, combining partial results in a fixed
+// order, i.e., results do not depend on the number of threads.
+
+// per-component minimum and maximum of all values
+template <typename T, typename Layout>
+std::pair<T, T> minmax(const tkernel<T, Layout> & kernel);
+
+// minimum and maximum over all components of all values
+template <typename T, typename Layout>
+std::pair<typename kernel_component<T>::type, typename kernel_component<T>::type> coefficient_minmax(const tkernel<T, Layout> & kernel);
+
+// per-component sum of all values (partial sums are combined pairwise)
+template <typename T, typename Layout>
+T sum(const tkernel<T, Layout> & kernel);
+
+// per-component arithmetic mean of all values
+template <typename T, typename Layout>
+T mean(const tkernel<T, Layout> & kernel);
+
+// per-component population variance of all values (Welford's method, with partial results combined
+// as described in "Updating Formulae and a Pairwise Algorithm for Computing Sample Variances" by Chan et al. in 1979)
+template <typename T, typename Layout>
+T variance(const tkernel<T, Layout> & kernel);
+
+// number of values per bin for one component, the bins subdividing [lower, upper] evenly
+// Note: values outside of [lower, upper] are not counted, upper is counted in the last bin
+template <typename T, typename Layout>
+std::vector<size_t> histogram(const tkernel<T, Layout> & kernel, size_t num_bins
+    , typename kernel_component<T>::type lower, typename kernel_component<T>::type upper, glm::length_t coefficient = 0);
+
+
+} // namespace reduce
+
+
+} // namespace glkernel
+
+
+#include <glkernel/reduce.hpp>
@@ -0,0 +1,194 @@
+
+#pragma once
+
+#include <glkernel/reduce.h>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#include <glm/common.hpp>
+
+#include <glkernel/glm_compatability.h>
+
+
+namespace glkernel
+{
+
+
+namespace reduce
+{
+
+
+namespace
+{
+
+// number of values accumulated sequentially per partial result
+constexpr size_t s_reduce_chunk_size = 1 << 12;
+
+// accumulates the values of each chunk in parallel and combines the partial results pairwise
+template <typename R, typename T, typename Layout, typename Accumulate, typename Combine>
+R reduce_chunks(const tkernel<T, Layout> & kernel, const R & identity, const Accumulate & accumulate, const Combine & combine)
+{
+    const auto size = kernel.size();
+    const auto num_chunks = (size + s_reduce_chunk_size - 1) / s_reduce_chunk_size;
+
+    if (num_chunks == 0)
+        return identity;
+
+    auto partials = std::vector<R>(num_chunks, identity);
+
+    #pragma omp parallel for
+    for (long long c = 0; c < static_cast<long long>(num_chunks); ++c)
+    {
+        const auto chunk = static_cast<size_t>(c);
+        const auto last = std::min((chunk + 1) * s_reduce_chunk_size, size);
+
+        auto partial = identity;
+        for (auto i = chunk * s_reduce_chunk_size; i < last; ++i)
+            partial = accumulate(partial, static_cast<T>(kernel[i]));
+
+        partials[chunk] = partial;
+    }
+
+    for (auto stride = size_t{ 1 }; stride < num_chunks; stride *= 2)
+        for (size_t i = 0; i + stride < num_chunks; i += 2 * stride)
+            partials[i] = combine(partials[i], partials[i + stride]);
+
+    return partials[0];
+}
+
+// running count, mean, and sum of squared deviations
+template <typename T>
+struct moments
+{
+    size_t count;
+    T mean;
+    T m2;
+};
+
+} // anonymous namespace
+
+
+template <typename T, typename Layout>
+std::pair<T, T> minmax(const tkernel<T, Layout> & kernel)
+{
+    using component_type = typename kernel_component<T>::type;
+
+    const auto identity = std::make_pair(T(std::numeric_limits<component_type>::max()), T(std::numeric_limits<component_type>::lowest()));
+
+    return reduce_chunks(kernel, identity
+        , [](const std::pair<T, T> & partial, const T & value)
+        {
+            return std::make_pair(glm::min(partial.first, value), glm::max(partial.second, value));
+        }
+        , [](const std::pair<T, T> & a, const std::pair<T, T> & b)
+        {
+            return std::make_pair(glm::min(a.first, b.first), glm::max(a.second, b.second));
+        });
+}
+
+template <typename T, typename Layout>
+std::pair<typename kernel_component<T>::type, typename kernel_component<T>::type> coefficient_minmax(const tkernel<T, Layout> & kernel)
+{
+    const auto bounds = minmax(kernel);
+
+    auto result = std::make_pair(kernel_coefficient(bounds.first, 0), kernel_coefficient(bounds.second, 0));
+    for (glm::length_t coefficient = 1; coefficient < kernel_length(bounds.first); ++coefficient)
+    {
+        result.first = std::min(result.first, kernel_coefficient(bounds.first, coefficient));
+        result.second = std::max(result.second, kernel_coefficient(bounds.second, coefficient));
+    }
+    return result;
+}
+
+template <typename T, typename Layout>
+T sum(const tkernel<T, Layout> & kernel)
+{
+    return reduce_chunks(kernel, T(0)
+        , [](const T & partial, const T & value) { return partial + value; }
+        , [](const T & a, const T & b) { return a + b; });
+}
+
+template <typename T, typename Layout>
+T mean(const tkernel<T, Layout> & kernel)
+{
+    using component_type = typename kernel_component<T>::type;
+
+    assert(kernel.size() > 0);
+    return sum(kernel) / static_cast<component_type>(kernel.size());
+}
+
+template <typename T, typename Layout>
+T variance(const tkernel<T, Layout> & kernel)
+{
+    using component_type = typename kernel_component<T>::type;
+
+    assert(kernel.size() > 0);
+
+    const auto result = reduce_chunks(kernel, moments<T>{ 0, T(0), T(0) }
+        , [](const moments<T> & partial, const T & value)
+        {
+            const auto count = partial.count + 1;
+            const auto delta = value - partial.mean;
+            const auto mean = partial.mean + delta / static_cast<component_type>(count);
+
+            return moments<T>{ count, mean, partial.m2 + delta * (value - mean) };
+        }
+        , [](const moments<T> & a, const moments<T> & b)
+        {
+            const auto count = a.count + b.count;
+            if (count == 0)
+                return a;
+
+            const auto delta = b.mean - a.mean;
+            const auto weight = static_cast<component_type>(b.count) / static_cast<component_type>(count);
+
+            return moments<T>{ count, a.mean + delta * weight
+                , a.m2 + b.m2 + delta * delta * static_cast<component_type>(a.count) * weight };
+        });
+
+    return result.m2 / static_cast<component_type>(result.count);
+}
+
+template <typename T, typename Layout>
+std::vector<size_t> histogram(const tkernel<T, Layout> & kernel, const size_t num_bins
+    , const typename kernel_component<T>::type lower, const typename kernel_component<T>::type upper, const glm::length_t coefficient)
+{
+    using component_type = typename kernel_component<T>::type;
+
+    assert(num_bins > 0);
+    assert(coefficient < kernel.length());
+
+    const auto size = static_cast<long long>(kernel.size());
+    const auto scale = upper > lower ? static_cast<component_type>(num_bins) / (upper - lower) : component_type(0);
+
+    auto bins = std::vector<size_t>(num_bins, 0);
+
+    #pragma omp parallel
+    {
+        auto local_bins = std::vector<size_t>(num_bins, 0);
+
+        #pragma omp for
+        for (long long i = 0; i < size; ++i)
+        {
+            const auto value = kernel_coefficient(static_cast<T>(kernel[static_cast<size_t>(i)]), coefficient);
+            if (!(value >= lower && value <= upper))
+                continue;
+
+            const auto bin = static_cast<size_t>((value - lower) * scale);
+            ++local_bins[std::min(bin, num_bins - 1)];
+        }
+
+        #pragma omp critical
+        for (size_t bin = 0; bin < num_bins; ++bin)
+            bins[bin] += local_bins[bin];
+    }
+    return bins;
+}
+
+
+} // namespace reduce
+
+
+} // namespace glkernel
@@ -4,6 +4,7 @@
 #include <glm/gtc/type_precision.hpp>
 
 #include <glkernel/Kernel.h>
+#include <glkernel/random.h>
 #include <glkernel/glm_compatability.h>
 
 
@@ -27,13 +28,36 @@ namespace sample
 
 // Guess a good number that targets the actual generated number of
 // points generated to match kernel's size.
-template <typename T, glm::precision P>
-size_t poisson_square(tkernel<glm::tvec2<T, P>> & kernel, unsigned int num_probes = 32);
+template <typename T, glm::precision P, typename Layout>
+size_t poisson_square(tkernel<glm::tvec2<T, P>, Layout> & kernel, unsigned int num_probes = 32, random::seed_type seed = random::nondeterministic_seed());
 
 // In contrast to the typical default impl. this impl uses the best
 // of num_probes, randomizes the actives, ...
-template <typename T, glm::precision P>
-size_t poisson_square(tkernel<glm::tvec2<T, P>> & kernel, T min_dist, unsigned int num_probes = 32);
+template <typename T, glm::precision P, typename Layout>
+size_t poisson_square(tkernel<glm::tvec2<T, P>, Layout> & kernel, T min_dist, unsigned int num_probes = 32, random::seed_type seed = random::nondeterministic_seed());
+//@}
+
+//@{
+/**
+*  @brief
+*    Values of the kernel are set to positions using parallel poisson disk sampling.
+*
+*    Darts are thrown into the cells of the occupancy grid (at most one sample per cell),
+*    with cells grouped into phases that are processed concurrently, since samples of cells
+*    of the same phase cannot conflict. Each empty cell receives up to num_probes darts, the
+*    first one keeping min_dist to all samples (tileable) is accepted. The results do not
+*    depend on the number of threads.
+*
+*  @return
+*    The number of actual generated points. Note: this number is
+*    between 0 and the kernel's size. If more samples are generated
+*    than the kernel holds, a random subset is kept.
+*/
+template <typename T, glm::precision P, typename Layout>
+size_t poisson_square_parallel(tkernel<glm::tvec2<T, P>, Layout> & kernel, unsigned int num_probes = 32, random::seed_type seed = random::nondeterministic_seed());
+
+template <typename T, glm::precision P, typename Layout>
+size_t poisson_square_parallel(tkernel<glm::tvec2<T, P>, Layout> & kernel, T min_dist, unsigned int num_probes = 32, random::seed_type seed = random::nondeterministic_seed());
 //@}
 
 //@{
@@ -55,15 +79,18 @@ size_t poisson_square(tkernel<glm::tvec2<T, P>> & kernel, T min_dist, unsigned i
 *    The kernel to be modified, with its extent specifying the number
 *    of strata. Note: the value type should match the kernels extent,
 *    e.g., a vec2 kernel should not be used for a kernel of 3d extent.
+*
+*  @param[in] seed
+*    Seed for the counter-based generator used for jittering
 */
-template <typename T, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
-void stratified(tkernel<T> & kernel);
+template <typename T, typename Layout, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
+void stratified(tkernel<T, Layout> & kernel, random::seed_type seed = random::nondeterministic_seed());
 
-template <typename T, glm::precision P>
-void stratified(tkernel<glm::tvec2<T, P>> & kernel);
+template <typename T, glm::precision P, typename Layout>
+void stratified(tkernel<glm::tvec2<T, P>, Layout> & kernel, random::seed_type seed = random::nondeterministic_seed());
 
-template <typename T, glm::precision P>
-void stratified(tkernel<glm::tvec3<T, P>> & kernel);
+template <typename T, glm::precision P, typename Layout>
+void stratified(tkernel<glm::tvec3<T, P>, Layout> & kernel, random::seed_type seed = random::nondeterministic_seed());
 
 /**
 *  @brief
@@ -72,8 +99,8 @@ void stratified(tkernel<glm::tvec3<T, P>> & kernel);
 *  @param[in,out] kernel
 *  The kernel to be modified
 */
-template <typename T, glm::precision P>
-void hammersley(tkernel<glm::tvec2<T, P>> & kernel);
+template <typename T, glm::precision P, typename Layout>
+void hammersley(tkernel<glm::tvec2<T, P>, Layout> & kernel);
 
 /**
 *  @brief
@@ -88,8 +115,8 @@ void hammersley(tkernel<glm::tvec2<T, P>> & kernel);
 *  @param[in] base2
 *  Base for the "van der Corput" sequence used for the y coordinates
 */
-template <typename T, glm::precision P>
-void halton(tkernel<glm::tvec2<T, P>> & kernel, const unsigned int base1, const unsigned int base2);
+template <typename T, glm::precision P, typename Layout>
+void halton(tkernel<glm::tvec2<T, P>, Layout> & kernel, const unsigned int base1, const unsigned int base2);
 
 /**
 *  @brief
@@ -111,9 +138,9 @@ enum class HemisphereMapping : unsigned char
 *  @param[in] type
 *  Mapping used for generating points on a sphere
 */
-template <typename T, glm::precision P>
+template <typename T, glm::precision P, typename Layout>
 void hammersley_sphere(
-    tkernel<glm::tvec3<T, P>> & kernel,
+    tkernel<glm::tvec3<T, P>, Layout> & kernel,
     const HemisphereMapping type = HemisphereMapping::Uniform);
 
 /**
@@ -132,27 +159,32 @@ void hammersley_sphere(
 *  @param[in] base2
 *  Base for the "van der Corput" sequence used for the y coordinates
 */
-template <typename T, glm::precision P>
+template <typename T, glm::precision P, typename Layout>
 void halton_sphere(
-    tkernel<glm::tvec3<T, P>> & kernel,
+    tkernel<glm::tvec3<T, P>, Layout> & kernel,
     const unsigned int base1,
     const unsigned int base2,
     const HemisphereMapping type = HemisphereMapping::Uniform);
 /*
 *  @brief
 *  Generates several candidates for each samples and selects the one
-*  that is farthest to the previously selected samples
+*  that is farthest to the previously selected samples (Mitchell's algorithm).
+*  Selected samples are kept in a uniform grid, so the nearest selected sample
+*  of a candidate is found by searching only the surrounding cells
 *
 *  @param[in,out] kernel
 *  The kernel to be modified
 *
 *  @param[in] num_candidates
 *  Number of candidates generated for each sample
+*
+*  @param[in] seed
+*  Seed for the counter-based generator used for the candidates
 */
-template <typename T, glm::precision P>
-void best_candidate(tkernel<glm::tvec2<T, P>> & kernel, unsigned int num_candidates = 32);
-template <typename T, glm::precision P>
-void best_candidate(tkernel<glm::tvec3<T, P>> & kernel, unsigned int num_candidates = 32);
+template <typename T, glm::precision P, typename Layout>
+void best_candidate(tkernel<glm::tvec2<T, P>, Layout> & kernel, unsigned int num_candidates = 32, random::seed_type seed = random::nondeterministic_seed());
+template <typename T, glm::precision P, typename Layout>
+void best_candidate(tkernel<glm::tvec3<T, P>, Layout> & kernel, unsigned int num_candidates = 32, random::seed_type seed = random::nondeterministic_seed());
 
 /**
 *  @brief
@@ -162,9 +194,12 @@ void best_candidate(tkernel<glm::tvec3<T, P>> & kernel, unsigned int num_candida
 *
 *  @param[in,out] kernel
 *  The kernel to be modified, size is used for number of samples
+*
+*  @param[in] seed
+*  Seed for the counter-based generator used for shuffling and jittering
 */
-template <typename T, glm::precision P>
-void n_rooks(tkernel<glm::tvec2<T, P>> & kernel);
+template <typename T, glm::precision P, typename Layout>
+void n_rooks(tkernel<glm::tvec2<T, P>, Layout> & kernel, random::seed_type seed = random::nondeterministic_seed());
 
 //@}
 /**
@@ -180,9 +215,39 @@ void n_rooks(tkernel<glm::tvec2<T, P>> & kernel);
 *
 *  @param[in,out] kernel
 *  The kernel to be modified, dimensions are used for number of strata
+*
+*  @param[in] seed
+*  Seed for the counter-based generator used for shuffling and jittering
+*/
+template <typename T, glm::precision P, typename Layout>
+void multi_jittered(tkernel<glm::tvec2<T, P>, Layout> & kernel, const bool correlated = false, random::seed_type seed = random::nondeterministic_seed());
+
+/**
+*  @brief
+*  Computes a single sample of a multi jittered pattern of width x height strata
+*
+*  The subcell permutations are hashed instead of stored (Kensler, "Correlated
+*  Multi-Jittered Sampling", 2013), so every sample is computed in constant time
+*  and memory, e.g., for generating patterns per pixel on demand. The result
+*  equals kernel[index] of multi_jittered for a kernel of the same extent.
+*
+*  @param[in] index
+*  Index of the sample, i.e., x + y * width of its stratum
+*
+*  @param[in] width
+*  Number of strata in x
+*
+*  @param[in] height
+*  Number of strata in y
+*
+*  @param[in] seed
+*  Seed selecting the pattern
+*
+*  @param[in] correlated
+*  Use the same shuffle pattern for all rows/column to reduce sample clumpiness
 */
-template <typename T, glm::precision P>
-void multi_jittered(tkernel<glm::tvec2<T, P>> & kernel, const bool correlated = false);
+template <typename T, glm::precision P = glm::highp>
+glm::tvec2<T, P> multi_jittered_sample(glm::uint32 index, glm::uint32 width, glm::uint32 height, random::seed_type seed, bool correlated = false);
 
 /**
 *  @brief
@@ -191,9 +256,116 @@ void multi_jittered(tkernel<glm::tvec2<T, P>> & kernel, const bool correlated =
 *
 *  @param[in,out] kernel
 *  The kernel to be modified
+*
+*  @param[in] seed
+*  Seed for the counter-based generator used for the initial coordinates
+*/
+template <typename T, glm::precision P, typename Layout>
+void golden_point_set(tkernel<glm::tvec2<T, P>, Layout> & kernel, random::seed_type seed = random::nondeterministic_seed());
+
+// number of dimensions with embedded direction numbers available for sobol
+const unsigned int sobol_dimensions = 16;
+
+/**
+*  @brief
+*  Generates the sobol sequence with Joe-Kuo direction numbers
+*
+*  Each coefficient of the kernel's values uses its own dimension, starting
+*  with first_dimension, e.g., a vec2 kernel uses dimensions 0 and 1. Higher
+*  dimensions (up to sobol_dimensions) can be generated into further kernels.
+*  The points are generated in Gray code order; the first 2^m points of
+*  dimensions 0 and 1 form a (0, m, 2)-net.
+*
+*  @param[in,out] kernel
+*  The kernel to be modified, size is used for number of samples
+*
+*  @param[in] scrambled
+*  Apply nested uniform (Owen) scrambling per dimension, which preserves the
+*  net properties while decorrelating differently seeded sequences
+*
+*  @param[in] seed
+*  Seed for the counter-based generator used for scrambling
+*
+*  @param[in] first_dimension
+*  Dimension used for the first coefficient of the kernel's values
+*/
+template <typename T, typename Layout, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
+void sobol(tkernel<T, Layout> & kernel, bool scrambled = false, random::seed_type seed = random::nondeterministic_seed(), unsigned int first_dimension = 0);
+
+template <typename V, typename Layout, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
+void sobol(tkernel<V, Layout> & kernel, bool scrambled = false, random::seed_type seed = random::nondeterministic_seed(), unsigned int first_dimension = 0);
+
+/**
+*  @brief
+*  Generates the hammersley point set at compile time
+*
+*  @tparam Kernel
+*  A static kernel of two-component vectors, e.g., static_kernel2<16>
+*
+*  @return
+*  Kernel with the point set (a constant expression)
+*/
+template <typename Kernel>
+constexpr Kernel hammersley();
+
+/**
+*  @brief
+*  Generates the halton point set at compile time
+*
+*  @tparam Kernel
+*  A static kernel of two-component vectors, e.g., static_kernel2<16>
+*
+*  @param[in] base1
+*  Base for the "van der Corput" sequence used for the x coordinates
+*
+*  @param[in] base2
+*  Base for the "van der Corput" sequence used for the y coordinates
+*
+*  @return
+*  Kernel with the point set (a constant expression)
+*/
+template <typename Kernel>
+constexpr Kernel halton(unsigned int base1, unsigned int base2);
+
+/**
+*  @brief
+*  Generates the hammersley point set mapped to a hemisphere at compile time
+*
+*  @tparam Kernel
+*  A static kernel of three-component vectors, e.g., static_kernel3<64>
+*
+*  @param[in] type
+*  Mapping used for generating points on a sphere
+*
+*  @return
+*  Kernel with the point set (a constant expression), matching the run-time
+*  generation up to rounding of the trigonometric functions
+*/
+template <typename Kernel>
+constexpr Kernel hammersley_sphere(HemisphereMapping type = HemisphereMapping::Uniform);
+
+/**
+*  @brief
+*  Generates the halton point set mapped to a hemisphere at compile time
+*
+*  @tparam Kernel
+*  A static kernel of three-component vectors, e.g., static_kernel3<64>
+*
+*  @param[in] base1
+*  Base for the "van der Corput" sequence used for the x coordinates
+*
+*  @param[in] base2
+*  Base for the "van der Corput" sequence used for the y coordinates
+*
+*  @param[in] type
+*  Mapping used for generating points on a sphere
+*
+*  @return
+*  Kernel with the point set (a constant expression), matching the run-time
+*  generation up to rounding of the trigonometric functions
 */
-template <typename T, glm::precision P>
-void golden_point_set(tkernel<glm::tvec2<T, P>> & kernel);
+template <typename Kernel>
+constexpr Kernel halton_sphere(unsigned int base1, unsigned int base2, HemisphereMapping type = HemisphereMapping::Uniform);
 
 
 } // namespace sample
@@ -4,14 +4,13 @@
 #include <glkernel/sample.h>
 
 #include <cassert>
-#include <random>
 #include <vector>
 #include <array>
-#include <list>
 #include <iterator>
 #include <tuple>
 #include <algorithm>
 #include <numeric>
+#include <limits>
 
 #include <glkernel/glm_compatability.h>
 
@@ -36,21 +35,39 @@ struct poisson_square_map
     : m_none{ static_cast<size_t>(-1) }
     , m_side{ static_cast<size_t>(std::ceil(sqrt(2.0) / min_dist)) }
     , m_dist2(min_dist * min_dist)
+    , m_corners{ min_dist * m_side > sqrt(2.0) }
     {
         m_mask.resize(m_side * m_side, m_none);
     }
 
-    void mask(const glm::tvec2<T, P> & point, const size_t k)
+    size_t side() const
+    {
+        return m_side;
+    }
+
+    size_t cell(const glm::tvec2<T, P> & point) const
     {
         const auto s = static_cast<int>(m_side);
-        const auto o = static_cast<int>(point.y * s) * s + static_cast<int>(point.x * s);
+        return static_cast<size_t>(static_cast<int>(point.y * s) * s + static_cast<int>(point.x * s));
+    }
+
+    bool occupied(const size_t cell) const
+    {
+        return m_mask[cell] != m_none;
+    }
+
+    void mask(const glm::tvec2<T, P> & point, const size_t k)
+    {
+        const auto o = cell(point);
 
         assert(m_mask[o] == m_none);
 
         m_mask[o] = k;
     }
 
-    bool masked(const glm::tvec2<T, P> & probe, const tkernel<glm::tvec2<T, P>> & kernel) const
+    // points are accessed by the indices given to mask (e.g., a kernel)
+    template <typename Points>
+    bool masked(const glm::tvec2<T, P> & probe, const Points & points) const
     {
         const auto s = static_cast<int>(m_side);
 
@@ -62,8 +79,8 @@ struct poisson_square_map
         for (int j = y - 2; j < y + 3; ++j)
             for (int i = x - 2; i < x + 3; ++i)
             {
-                // optimization: skip the 4 corner cases, since the fall not within distance anyway ...
-                if ((j == corners[0] || j == corners[2]) && (i == corners[1] || i == corners[3])) 
+                // optimization: skip the 4 corner cases, their points are at least sqrt(2) cells away ...
+                if (!m_corners && (j == corners[0] || j == corners[2]) && (i == corners[1] || i == corners[3]))
                     continue;
 
                 const auto i_tiled = i < 0 ? i + s : i % s;
@@ -73,7 +90,7 @@ struct poisson_square_map
                 if (o == m_none)
                     continue;
 
-                auto masking_probe = kernel[o];
+                auto masking_probe = static_cast<glm::tvec2<T, P>>(points[o]);
 
                 if (i < 0)
                     masking_probe.x -= 1.0;
@@ -100,61 +117,61 @@ protected:
     size_t m_side;
     T m_dist2;
 
+    // whether min_dist exceeds sqrt(2) cells, i.e., the corner cells can conflict as well
+    bool m_corners;
+
     std::vector<size_t> m_mask;
 };
 
 
-template <typename T, glm::precision P>
-size_t poisson_square(tkernel<glm::tvec2<T, P>> & kernel, const unsigned int num_probes)
+template <typename T, glm::precision P, typename Layout>
+size_t poisson_square(tkernel<glm::tvec2<T, P>, Layout> & kernel, const unsigned int num_probes, const random::seed_type seed)
 {
     assert(kernel.depth() == 1);
 
     const T min_dist = 1 / sqrt(static_cast<T>(kernel.size() * sqrt(2)));
-    return poisson_square(kernel, min_dist, num_probes);
+    return poisson_square(kernel, min_dist, num_probes, seed);
 }
 
 
-template <typename T, glm::precision P>
-size_t poisson_square(tkernel<glm::tvec2<T, P>> & kernel, const T min_dist, const unsigned int num_probes)
+template <typename T, glm::precision P, typename Layout>
+size_t poisson_square(tkernel<glm::tvec2<T, P>, Layout> & kernel, const T min_dist, const unsigned int num_probes, const random::seed_type seed)
 {
     assert(kernel.depth() == 1);
 
-    std::random_device RD;
-    std::mt19937_64 generator(RD());
-
-    std::uniform_real_distribution<> radius_dist(min_dist, min_dist * 2.0);
-    std::uniform_real_distribution<> angle_dist(0.0, 2.0 * glm::pi<T>());
-
-    std::uniform_int_distribution<> int_distribute(0, std::numeric_limits<int>::max());
+    // every iteration uses stream 0 for picking and one stream per probe
+    glm::uint64 iteration = 0;
 
     auto occupancy = poisson_square_map<T, P>{ min_dist };
 
     size_t k = 0; // number of valid/final points within the kernel
     kernel[k] = glm::tvec2<T, P>(0.5, 0.5);
 
-    auto actives = std::list<size_t>();
+    // active points are removed by swapping with the last one, keeping picks in constant time
+    auto actives = std::vector<size_t>{ };
+    actives.reserve(kernel.size());
     actives.push_back(k);
 
     occupancy.mask(kernel[k], k);
 
+    // probe positions and their squared distances to the active point (negative if masked)
+    auto probes = std::vector<std::tuple<glm::tvec2<T, P>, T>>(num_probes);
+
     while (!actives.empty() && k < kernel.size() - 1)
     {
-        // randomly pick an active point
-        const auto pick = int_distribute(generator);
-
-        auto pick_it = actives.begin();
-        std::advance(pick_it, pick % actives.size());
-
-        const auto active = kernel[*pick_it];
+        ++iteration;
 
+        // randomly pick an active point
+        auto generator = random::philox_engine{ seed, iteration };
+        const auto pick = random::bounded(generator, static_cast<glm::uint32>(actives.size()));
 
-        std::vector<std::tuple<glm::tvec2<T, P>, T>> probes{ num_probes };
+        const auto active = static_cast<glm::tvec2<T, P>>(kernel[actives[pick]]);
 
-        #pragma omp parallel for
         for (int i = 0; i < static_cast<int>(num_probes); ++i)
         {
-            const auto r = radius_dist(generator);
-            const auto a = angle_dist(generator);
+            auto probe_generator = random::philox_engine{ seed, iteration, static_cast<glm::uint32>(i + 1) };
+            const auto r = random::uniform(probe_generator, min_dist, min_dist * 2);
+            const auto a = random::uniform(probe_generator, static_cast<T>(0), 2 * glm::pi<T>());
 
             auto probe = glm::tvec2<T, P>{ active.x + r * cos(a), active.y + r * sin(a) };
 
@@ -177,12 +194,11 @@ size_t poisson_square(tkernel<glm::tvec2<T, P>> & kernel, const T min_dist, cons
             const auto masked = occupancy.masked(probe, kernel);
             const auto delta = glm::abs(active - probe);
 
-            probes[i] = std::make_tuple<glm::tvec2<T, P>, T>(std::move(probe), 
-                (masked ? static_cast<T>(-1.0) : glm::dot(delta, delta)));
+            probes[i] = std::make_tuple(probe, (masked ? static_cast<T>(-1.0) : glm::dot(delta, delta)));
         }
         
         // pick nearest probe from sample set
-        glm::vec2 nearest_probe;
+        glm::tvec2<T, P> nearest_probe;
         auto nearest_dist = 4 * min_dist * min_dist;
         auto nearest_found = false;
 
@@ -202,7 +218,8 @@ size_t poisson_square(tkernel<glm::tvec2<T, P>> & kernel, const T min_dist, cons
 
         if (!nearest_found && (actives.size() > 0 || k > 1))
         {
-            actives.erase(pick_it);
+            actives[pick] = actives.back();
+            actives.pop_back();
             continue;
         }
 
@@ -215,98 +232,167 @@ size_t poisson_square(tkernel<glm::tvec2<T, P>> & kernel, const T min_dist, cons
     return k + 1;
 }
 
-template <typename T, glm::precision P>
-void multi_jittered(tkernel<glm::tvec2<T, P>> & kernel, const bool correlated)
+template <typename T, glm::precision P, typename Layout>
+size_t poisson_square_parallel(tkernel<glm::tvec2<T, P>, Layout> & kernel, const unsigned int num_probes, const random::seed_type seed)
 {
     assert(kernel.depth() == 1);
 
-    std::random_device RD;
-    std::mt19937_64 generator(RD());
+    const T min_dist = 1 / sqrt(static_cast<T>(kernel.size() * sqrt(2)));
+    return poisson_square_parallel(kernel, min_dist, num_probes, seed);
+}
 
-    const auto stratum_size = 1.0 / (kernel.width() * kernel.height());
-    const auto subcell_width = 1.0 / kernel.width();
-    const auto subcell_height = 1.0 / kernel.height();
 
-    std::uniform_real_distribution<> jitter_dist(0.0, stratum_size);
+template <typename T, glm::precision P, typename Layout>
+size_t poisson_square_parallel(tkernel<glm::tvec2<T, P>, Layout> & kernel, const T min_dist, const unsigned int num_probes, const random::seed_type seed)
+{
+    assert(kernel.depth() == 1);
 
-    // create pools of subcell indices
-    std::vector<std::vector<int>> column_indices(kernel.width());
-    std::vector<std::vector<int>> row_indices(kernel.height());
+    // the occupancy grid tests for conflicts within two cells, which suffices as long as min_dist
+    // spans less than two cells, i.e., min_dist * ceil(sqrt(2) / min_dist) < 2
+    assert(min_dist < static_cast<T>(2.0 - sqrt(2.0)));
 
-    // reverse height and width inside subcells
-    for (auto y = 0; y < kernel.width(); ++y)
-    {
-        // use the same shuffle pattern for all rows for correlated shuffling
-        if (y != 0 && correlated)
-        {
-            column_indices[y] = column_indices[0];
-            continue;
-        }
+    auto occupancy = poisson_square_map<T, P>{ min_dist };
+
+    const auto side = static_cast<int>(occupancy.side());
+    const auto cell_size = static_cast<T>(1) / side;
 
-        // shuffle columns separately to keep n-rooks condition satisfied
-        for (auto x = 0; x < kernel.height(); ++x)
+    // Cells are partitioned into phase groups, with cells of the same phase being at least three
+    // cells apart (also across the tiled borders). Samples within these cells cannot conflict, and
+    // each cell only reads masks within two cells of itself. Hence, darts are thrown into all cells
+    // of a phase concurrently. Columns and rows exceeding a multiple of three form phases of their own.
+    const auto regular = side - side % 3;
+    const auto num_phases = 3 + side % 3;
+
+    auto phases = std::vector<std::vector<size_t>>(num_phases * num_phases);
+    for (int y = 0; y < side; ++y)
+        for (int x = 0; x < side; ++x)
         {
-            column_indices[y].push_back(x);
+            const auto phase_x = x < regular ? x % 3 : 3 + x - regular;
+            const auto phase_y = y < regular ? y % 3 : 3 + y - regular;
+            phases[phase_y * num_phases + phase_x].push_back(static_cast<size_t>(y * side + x));
         }
-        std::random_shuffle(column_indices[y].begin(), column_indices[y].end());
-    }
-    // reverse height and width inside subcells
-    for (auto x = 0; x < kernel.height(); ++x)
+
+    // random phase order reduces grid aligned artifacts
+    auto generator = random::philox_engine{ seed, 0, 0 };
+    random::shuffle(phases.begin(), phases.end(), generator);
+
+    // the sample of each cell, referenced by the cell index within the occupancy grid
+    auto samples = std::vector<glm::tvec2<T, P>>(static_cast<size_t>(side) * side);
+
+    for (const auto & cells : phases)
     {
-        // use the same shuffle pattern for all columns for correlated shuffling
-        if (x != 0 && correlated)
+        #pragma omp parallel for
+        for (long long i = 0; i < static_cast<long long>(cells.size()); ++i)
         {
-            row_indices[x] = row_indices[0];
-            continue;
-        }
+            const auto o = cells[i];
+            const auto x = static_cast<int>(o % side);
+            const auto y = static_cast<int>(o / side);
 
-        // shuffle rows separately to keep n-rooks condition satisfied
-        for (auto y = 0; y < kernel.width(); ++y)
-        {
-            row_indices[x].push_back(y);
+            // throw up to num_probes darts into the cell, accepting the first one without conflicts
+            auto dart_generator = random::philox_engine{ seed, o, 1 };
+            for (unsigned int dart = 0; dart < num_probes; ++dart)
+            {
+                const auto u = random::uniform<T>(dart_generator);
+                const auto v = random::uniform<T>(dart_generator);
+                const auto probe = glm::tvec2<T, P>{ (x + u) * cell_size, (y + v) * cell_size };
+
+                // skip darts rounded into an adjacent cell
+                if (occupancy.cell(probe) != o || occupancy.masked(probe, samples))
+                    continue;
+
+                samples[o] = probe;
+                occupancy.mask(probe, o);
+                break;
+            }
         }
-        std::random_shuffle(row_indices[x].begin(), row_indices[x].end());
     }
 
-    int k = 0;
+    // gather samples in random cell order, so that a kernel too small for all samples
+    // retains a uniformly distributed subset
+    auto order = std::vector<size_t>(samples.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    generator = random::philox_engine{ seed, 0, 2 };
+    random::shuffle(order.begin(), order.end(), generator);
+
+    size_t k = 0;
+    for (size_t i = 0; i < order.size() && k < kernel.size(); ++i)
+    {
+        if (occupancy.occupied(order[i]))
+            kernel[k++] = samples[order[i]];
+    }
+
+    return k;
+}
+
+template <typename T, glm::precision P>
+glm::tvec2<T, P> multi_jittered_sample(
+    const glm::uint32 index
+,   const glm::uint32 width
+,   const glm::uint32 height
+,   const random::seed_type seed
+,   const bool correlated)
+{
+    assert(width > 0 && height > 0);
+    assert(index < static_cast<glm::uint64>(width) * height);
+
+    const auto x = index % width;
+    const auto y = index / width;
+
+    // the subcell offsets within a column (row) are a permutation of the rows (columns),
+    // keyed per column (row), or shared by all columns (rows) for correlated sampling
+    auto x_key = random::philox_engine{ seed, correlated ? 0u : x, 0 };
+    auto y_key = random::philox_engine{ seed, correlated ? 0u : y, 1 };
+
+    const auto x_offset = random::permute(y, height, x_key());
+    const auto y_offset = random::permute(x, width, y_key());
+
+    auto generator = random::philox_engine{ seed, index, 2 };
+    const auto x_jitter = random::uniform<double>(generator);
+    const auto y_jitter = random::uniform<double>(generator);
+
+    return glm::tvec2<T, P>(
+        (x + (x_offset + x_jitter) / height) / width,
+        (y + (y_offset + y_jitter) / width) / height);
+}
+
+template <typename T, glm::precision P, typename Layout>
+void multi_jittered(tkernel<glm::tvec2<T, P>, Layout> & kernel, const bool correlated, const random::seed_type seed)
+{
+    assert(kernel.depth() == 1);
+    assert(kernel.size() <= std::numeric_limits<glm::uint32>::max());
+
     #pragma omp parallel for
-    for (auto x = 0; x < kernel.width(); ++x)
+    for (long long i = 0; i < static_cast<long long>(kernel.size()); ++i)
     {
-        for (auto y = 0; y < kernel.height(); ++y)
-        {
-            // use subcell_positions for shuffled in-cell positions
-            const auto x_coord = x * subcell_width + column_indices[x][y] * stratum_size + jitter_dist(generator);
-            const auto y_coord = y * subcell_height + row_indices[y][x] * stratum_size + jitter_dist(generator);
-            kernel.value(static_cast<glm::uint16>(x), static_cast<glm::uint16>(y)) = glm::tvec2<T, P>(x_coord, y_coord);
-            ++k;
-        }
+        kernel[i] = multi_jittered_sample<T, P>(static_cast<glm::uint32>(i), kernel.width(), kernel.height(), seed, correlated);
     }
 }
 
 
-template <typename T, glm::precision P>
-void n_rooks(tkernel<glm::tvec2<T, P>> & kernel)
+template <typename T, glm::precision P, typename Layout>
+void n_rooks(tkernel<glm::tvec2<T, P>, Layout> & kernel, const random::seed_type seed)
 {
     assert(kernel.depth() == 1);
 
     const auto stratum_size = 1.0 / kernel.size();
-    std::random_device RD;
-    std::mt19937_64 generator(RD());
-    // use uniform distribution for jittering inside strata
-    std::uniform_real_distribution<> jitter_dist(0.0, stratum_size);
 
     // create pool of column indices and shuffle it
-    std::vector<int> columnIndices = std::vector<int>(kernel.size());
+    std::vector<size_t> columnIndices = std::vector<size_t>(kernel.size());
     std::iota(columnIndices.begin(), columnIndices.end(), 0);
 
-    std::random_shuffle(columnIndices.begin(), columnIndices.end());
+    auto generator = random::philox_engine{ seed, 0, 0 };
+    random::shuffle(columnIndices.begin(), columnIndices.end(), generator);
 
     // use columnIndices to shuffle samples in y-direction
     #pragma omp parallel for
-    for (int k = 0; k < static_cast<int>(kernel.size()); ++k)
+    for (long long k = 0; k < static_cast<long long>(kernel.size()); ++k)
     {
-        const auto x_coord = k * stratum_size + jitter_dist(generator);
-        const auto y_coord = columnIndices.at(k) * stratum_size + jitter_dist(generator);
+        // use uniform distribution for jittering inside strata
+        auto jitter_generator = random::philox_engine{ seed, static_cast<glm::uint64>(k), 1 };
+
+        const auto x_coord = k * stratum_size + random::uniform(jitter_generator, 0.0, stratum_size);
+        const auto y_coord = columnIndices.at(k) * stratum_size + random::uniform(jitter_generator, 0.0, stratum_size);
         kernel[k] = glm::tvec2<T, P>(x_coord, y_coord);
     }
 }
@@ -315,16 +401,16 @@ template <typename T>
 class stratified_operator
 {
 public:
-    stratified_operator(const glm::u16vec3 & extent, glm::length_t);
+    stratified_operator(const glm::u32vec3 & extent, glm::length_t, random::seed_type seed);
 
     template <typename F, glm::precision P, template<typename, glm::precision> class V>
-    stratified_operator(const glm::u16vec3 & extent, glm::length_t coefficient);
+    stratified_operator(const glm::u32vec3 & extent, glm::length_t coefficient, random::seed_type seed);
 
-    T operator()(const glm::u16vec3 & position);
+    T operator()(const glm::u32vec3 & position);
 
 protected:
-    std::mt19937_64 m_generator;
-    std::uniform_real_distribution<T> m_distribute;
+    const glm::u32vec3 m_extent;
+    const random::seed_type m_seed;
 
     const T m_extent_inverse;
     const glm::length_t m_coefficient;
@@ -332,9 +418,9 @@ protected:
 
 
 template<typename T>
-stratified_operator<T>::stratified_operator(const glm::u16vec3 & extent, const glm::length_t coefficient)
-: m_generator{ std::random_device{}() }
-, m_distribute{ static_cast<T>(0.0), static_cast<T>(1.0) / extent[coefficient] }
+stratified_operator<T>::stratified_operator(const glm::u32vec3 & extent, const glm::length_t coefficient, const random::seed_type seed)
+: m_extent{ extent }
+, m_seed{ seed }
 , m_extent_inverse{ static_cast<T>(1.0) / extent[coefficient] }
 , m_coefficient{ coefficient }
 {
@@ -342,41 +428,44 @@ stratified_operator<T>::stratified_operator(const glm::u16vec3 & extent, const g
 
 template <typename T>
 template <typename F, glm::precision P, template<typename, glm::precision> class V>
-stratified_operator<T>::stratified_operator(const glm::u16vec3 & extent, const glm::length_t coefficient)
-: stratified_operator{ extent, coefficient }
+stratified_operator<T>::stratified_operator(const glm::u32vec3 & extent, const glm::length_t coefficient, const random::seed_type seed)
+: stratified_operator{ extent, coefficient, seed }
 {
 }
 
 template<typename T>
-T stratified_operator<T>::operator()(const glm::u16vec3 & position)
+T stratified_operator<T>::operator()(const glm::u32vec3 & position)
 {
-    return position[m_coefficient] * m_extent_inverse + m_distribute(m_generator);
+    const auto index = (static_cast<glm::uint64>(position[2]) * m_extent[1] + position[1]) * m_extent[0] + position[0];
+    auto generator = random::philox_engine{ m_seed, index, static_cast<glm::uint32>(m_coefficient) };
+
+    return position[m_coefficient] * m_extent_inverse + random::uniform(generator, static_cast<T>(0.0), m_extent_inverse);
 }
 
-template <typename T, typename std::enable_if<std::is_floating_point<T>::value>::type *>
-void stratified(tkernel<T> & kernel)
+template <typename T, typename Layout, typename std::enable_if<std::is_floating_point<T>::value>::type *>
+void stratified(tkernel<T, Layout> & kernel, const random::seed_type seed)
 {
     // the kernels dimensionality should match its value type,
     // i.e., at least two dimensions should be unused (equal 1)
     assert(kernel.depth() == 1 && kernel.height()  == 1);
-    kernel.template for_each_position<stratified_operator<T>>();
+    kernel.template for_each_position<stratified_operator<T>>(seed);
 }
 
-template <typename T, glm::precision P>
-void stratified(tkernel<glm::tvec2<T, P>> & kernel)
+template <typename T, glm::precision P, typename Layout>
+void stratified(tkernel<glm::tvec2<T, P>, Layout> & kernel, const random::seed_type seed)
 {
     // the kernels dimensionality should match its value type,
     // i.e., at least one dimension should be unused (equal 1)
     assert(kernel.depth() == 1);
-    kernel.template for_each_position<stratified_operator<T>>();
+    kernel.template for_each_position<stratified_operator<T>>(seed);
 }
 
-template <typename T, glm::precision P>
-void stratified(tkernel<glm::tvec3<T, P>> & kernel)
+template <typename T, glm::precision P, typename Layout>
+void stratified(tkernel<glm::tvec3<T, P>, Layout> & kernel, const random::seed_type seed)
 {
     // the kernels dimensionality should match its value type,
     // i.e., all three dimensions can be used (no assert required)
-    kernel.template for_each_position<stratified_operator<T>>();
+    kernel.template for_each_position<stratified_operator<T>>(seed);
 }
 namespace {
 
@@ -384,237 +473,631 @@ namespace {
 // http://holger.dammertz.org/stuff/notes_HammersleyOnHemisphere.html
 // which is licensed under http://creativecommons.org/licenses/by/3.0/
 
+constexpr unsigned int swap_bits(const unsigned int bits, const unsigned int mask, const unsigned int shift)
+{
+    return ((bits & mask) << shift) | ((bits & ~mask) >> shift);
+}
+
+constexpr unsigned int reverse_bits(const unsigned int bits)
+{
+    return swap_bits(swap_bits(swap_bits(swap_bits(swap_bits(bits
+        , 0x0000FFFFu, 16u), 0x55555555u, 1u), 0x33333333u, 2u), 0x0F0F0F0Fu, 4u), 0x00FF00FFu, 8u);
+}
+
 template <typename T>
-T radical_inverse(unsigned int bits)
+constexpr T radical_inverse(const unsigned int bits)
 {
     // the bit order of the number is inversed and interpreted as a float
-    bits = (bits << 16u) | (bits >> 16u);
-    bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
-    bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
-    bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
-    bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
-    return static_cast<T>(bits) * static_cast<T>(2.3283064365386963e-10); // divide by 2^32
+    return static_cast<T>(reverse_bits(bits))
+        * static_cast<T>(2.3283064365386963e-10); // divide by 2^32
+}
+
+template <typename T>
+constexpr T van_der_corput(const unsigned int n, const unsigned int base, const T inverse, const T inverse_power, const T result)
+{
+    return n == 0 ? result
+        : van_der_corput<T>(n / base, base, inverse, inverse_power * inverse, result + (n % base) * inverse_power);
+}
+
+template <typename T>
+constexpr T van_der_corput(const unsigned int n, const unsigned int base)
+{
+    return base == 2 ? radical_inverse<T>(n)
+        : van_der_corput<T>(n, base, 1 / static_cast<T>(base), 1 / static_cast<T>(base), static_cast<T>(0));
+}
+
+// constexpr (C++11) replacements of sqrt, sin, and cos used for compile-time generation
+
+constexpr double static_sqrt(const double x, const double current, const double previous, const unsigned int steps)
+{
+    // newton iteration, converging from above
+    return current == previous || steps == 0 ? current
+        : static_sqrt(x, 0.5 * (current + x / current), current, steps - 1);
+}
+
+constexpr double static_sqrt(const double x)
+{
+    return x <= 0.0 ? 0.0 : static_sqrt(x, x > 1.0 ? x : 1.0, 0.0, 64);
+}
+
+constexpr double static_taylor(const double x2, const double term, const double sum, const unsigned int n)
+{
+    // adds terms of the alternating series until they vanish
+    return sum + term == sum ? sum
+        : static_taylor(x2, -term * x2 / ((n + 1) * (n + 2)), sum + term, n + 2);
+}
+
+constexpr double static_wrap(const double x)
+{
+    // maps [0, 2pi) to [-pi, pi) for faster convergence
+    return x >= 3.14159265358979323846 ? x - 2.0 * 3.14159265358979323846 : x;
+}
+
+constexpr double static_sin(const double x)
+{
+    return static_taylor(static_wrap(x) * static_wrap(x), static_wrap(x), 0.0, 1);
+}
+
+constexpr double static_cos(const double x)
+{
+    return static_taylor(static_wrap(x) * static_wrap(x), 1.0, 0.0, 0);
 }
 
 template <typename T>
-T van_der_corput(unsigned int n, const unsigned int base)
+constexpr T static_hemisphere_component(const T phi, const T cos_theta, const glm::length_t coefficient)
 {
-    if (base == 2)
+    return coefficient == 2 ? cos_theta
+        : static_cast<T>(coefficient == 0 ? static_cos(phi) : static_sin(phi))
+            * static_cast<T>(static_sqrt(1 - cos_theta * cos_theta));
+}
+
+template <typename T>
+constexpr T static_hemisphere_component(const T u, const T v, const HemisphereMapping type, const glm::length_t coefficient)
+{
+    return static_hemisphere_component<T>(v * 2 * static_cast<T>(3.14159265358979323846)
+        , type == HemisphereMapping::Cosine ? static_cast<T>(static_sqrt(1 - u)) : 1 - u, coefficient);
+}
+
+// generators for the compile-time point sets, providing each component by index and coefficient
+
+template <typename T>
+struct hammersley_generator
+{
+    constexpr T operator()(const size_t index, const glm::length_t coefficient) const
     {
-        return radical_inverse<T>(n);
+        return coefficient == 0 ? static_cast<T>(index) / m_size : radical_inverse<T>(static_cast<unsigned int>(index));
     }
 
-    const T inverse = 1 / static_cast<T>(base);
-    T result = 0;
-    for (T inverse_power = inverse; n != 0; inverse_power *= inverse)
+    size_t m_size;
+};
+
+template <typename T>
+struct halton_generator
+{
+    constexpr T operator()(const size_t index, const glm::length_t coefficient) const
+    {
+        return van_der_corput<T>(static_cast<unsigned int>(index), coefficient == 0 ? m_base1 : m_base2);
+    }
+
+    unsigned int m_base1;
+    unsigned int m_base2;
+};
+
+template <typename T>
+struct hammersley_sphere_generator
+{
+    constexpr T operator()(const size_t index, const glm::length_t coefficient) const
+    {
+        return static_hemisphere_component<T>(static_cast<T>(index) / m_size
+            , radical_inverse<T>(static_cast<unsigned int>(index)), m_type, coefficient);
+    }
+
+    size_t m_size;
+    HemisphereMapping m_type;
+};
+
+template <typename T>
+struct halton_sphere_generator
+{
+    constexpr T operator()(const size_t index, const glm::length_t coefficient) const
+    {
+        return static_hemisphere_component<T>(van_der_corput<T>(static_cast<unsigned int>(index), m_base1)
+            , van_der_corput<T>(static_cast<unsigned int>(index), m_base2), m_type, coefficient);
+    }
+
+    unsigned int m_base1;
+    unsigned int m_base2;
+    HemisphereMapping m_type;
+};
+
+} // anonymous namespace
+
+// radical inverses of consecutive indices, generated in batches: indices of a block share
+// their high digits, so only the radical inverses of the low digits (and for hemisphere
+// mappings their sines and cosines) are required, which are tabulated once per base
+
+template <typename T>
+class radical_inverse_engine
+{
+public:
+    // number of consecutive indices generated at once (by a single thread)
+    static const size_t s_batch_size = 1024;
+
+    radical_inverse_engine(unsigned int base, size_t size, bool angles);
+
+    // radical inverses of the indices [first, first + count)
+    void inverses(size_t first, size_t count, T * values) const;
+
+    // cosines and sines of the radical inverses scaled by 2 pi (requires angles)
+    void sincos(size_t first, size_t count, T * cosines, T * sines) const;
+
+protected:
+    static const size_t s_max_block_size = 4096;
+
+    T high_digits(size_t block) const;
+
+protected:
+    const unsigned int m_base;
+    size_t m_block_size;
+
+    std::vector<T> m_inverses;
+    std::vector<T> m_cosines;
+    std::vector<T> m_sines;
+};
+
+
+template <typename T>
+const size_t radical_inverse_engine<T>::s_batch_size;
+
+template <typename T>
+const size_t radical_inverse_engine<T>::s_max_block_size;
+
+template <typename T>
+radical_inverse_engine<T>::radical_inverse_engine(const unsigned int base, const size_t size, const bool angles)
+: m_base{ base }
+, m_block_size{ 1 }
+{
+    assert(base > 1);
+
+    // blocks cover whole powers of the base, but not (much) more than the requested size
+    while (m_block_size < size && m_block_size * base <= s_max_block_size)
+        m_block_size *= base;
+
+    m_inverses.resize(m_block_size);
+    for (size_t i = 0; i < m_block_size; ++i)
+        m_inverses[i] = van_der_corput<T>(static_cast<unsigned int>(i), base);
+
+    if (!angles)
+        return;
+
+    m_cosines.resize(m_block_size);
+    m_sines.resize(m_block_size);
+    for (size_t i = 0; i < m_block_size; ++i)
     {
-        result += (n % base) * inverse_power;
-        n /= base;
+        m_cosines[i] = std::cos(m_inverses[i] * 2 * glm::pi<T>());
+        m_sines[i] = std::sin(m_inverses[i] * 2 * glm::pi<T>());
     }
-    return result;
 }
 
-template <typename T, glm::precision P>
-glm::tvec3<T, P> hemisphere_sample_uniform(const T u, const T v)
+template <typename T>
+T radical_inverse_engine<T>::high_digits(const size_t block) const
 {
-    const T phi = v * 2 * glm::pi<T>();
-    const T cosTheta = 1 - u;
-    const T sinTheta = sqrt(1 - cosTheta * cosTheta);
-    return { cos(phi) * sinTheta, sin(phi) * sinTheta, cosTheta };
+    // the high digits follow the digits within the block
+    return van_der_corput<T>(static_cast<unsigned int>(block), m_base) / static_cast<T>(m_block_size);
 }
 
-template <typename T, glm::precision P>
-glm::tvec3<T, P> hemisphere_sample_cos(const T u, const T v)
+template <typename T>
+void radical_inverse_engine<T>::inverses(const size_t first, const size_t count, T * const values) const
 {
-    const T phi = v * 2 * glm::pi<T>();
-    const T cosTheta = sqrt(1 - u);
-    const T sinTheta = sqrt(1 - cosTheta * cosTheta);
-    return { cos(phi) * sinTheta, sin(phi) * sinTheta, cosTheta };
+    if (m_base == 2)
+    {
+        // bit reversal, exact for all indices
+        for (size_t i = 0; i < count; ++i)
+            values[i] = radical_inverse<T>(static_cast<unsigned int>(first + i));
+        return;
+    }
+
+    for (size_t i = 0; i < count; )
+    {
+        const auto block = (first + i) / m_block_size;
+        const auto low = (first + i) % m_block_size;
+        const auto n = std::min(m_block_size - low, count - i);
+
+        const auto high = high_digits(block);
+        for (size_t j = 0; j < n; ++j)
+            values[i + j] = m_inverses[low + j] + high;
+
+        i += n;
+    }
 }
 
-} // anonymous namespace
+template <typename T>
+void radical_inverse_engine<T>::sincos(const size_t first, const size_t count, T * const cosines, T * const sines) const
+{
+    assert(m_cosines.size() == m_block_size);
 
-template <typename T, glm::precision P>
-void hammersley(tkernel<glm::tvec2<T, P>> & kernel)
+    for (size_t i = 0; i < count; )
+    {
+        const auto block = (first + i) / m_block_size;
+        const auto low = (first + i) % m_block_size;
+        const auto n = std::min(m_block_size - low, count - i);
+
+        // angle addition of the block's angle and the tabulated angles
+        const auto angle = high_digits(block) * 2 * glm::pi<T>();
+        const auto cos_high = std::cos(angle);
+        const auto sin_high = std::sin(angle);
+
+        for (size_t j = 0; j < n; ++j)
+        {
+            cosines[i + j] = cos_high * m_cosines[low + j] - sin_high * m_sines[low + j];
+            sines[i + j] = sin_high * m_cosines[low + j] + cos_high * m_sines[low + j];
+        }
+
+        i += n;
+    }
+}
+
+template <typename T, glm::precision P, typename Kernel>
+void hemisphere_batch(Kernel & kernel, const size_t first, const size_t count
+    , const T * u, const T * cosines, const T * sines, const HemisphereMapping type)
 {
-    #pragma omp parallel for
-    for (int i = 0; i < static_cast<int>(kernel.size()); ++i)
+    // phi is given by its cosine and sine, theta depends on the mapping
+    switch (type)
     {
-        const auto u = static_cast<T>(i) / kernel.size();
-        const auto v = radical_inverse<T>(i);
-        kernel[i] = glm::tvec2<T, P>(u, v);
+    case HemisphereMapping::Uniform:
+        for (size_t i = 0; i < count; ++i)
+        {
+            const T cosTheta = 1 - u[i];
+            const T sinTheta = std::sqrt(1 - cosTheta * cosTheta);
+            kernel[first + i] = glm::tvec3<T, P>(cosines[i] * sinTheta, sines[i] * sinTheta, cosTheta);
+        }
+        break;
+    case HemisphereMapping::Cosine:
+        for (size_t i = 0; i < count; ++i)
+        {
+            const T cosTheta = std::sqrt(1 - u[i]);
+            const T sinTheta = std::sqrt(1 - cosTheta * cosTheta);
+            kernel[first + i] = glm::tvec3<T, P>(cosines[i] * sinTheta, sines[i] * sinTheta, cosTheta);
+        }
+        break;
+    default:
+        break;
     }
 }
 
-template <typename T, glm::precision P>
-void hammersley_sphere(tkernel<glm::tvec3<T, P>> & kernel, const HemisphereMapping type)
+template <typename T, glm::precision P, typename Layout>
+void hammersley(tkernel<glm::tvec2<T, P>, Layout> & kernel)
 {
-    #pragma omp parallel for
-    for (int i = 0; i < static_cast<int>(kernel.size()); ++i)
+    using engine_type = radical_inverse_engine<T>;
+
+    const auto size = kernel.size();
+    const auto engine = engine_type{ 2, size, false };
+
+    const auto num_batches = static_cast<long long>((size + engine_type::s_batch_size - 1) / engine_type::s_batch_size);
+
+    #pragma omp parallel
     {
-        const auto u = static_cast<T>(i) / kernel.size();
-        const auto v = radical_inverse<T>(i);
-        switch (type)
+        auto v = std::vector<T>(engine_type::s_batch_size);
+
+        #pragma omp for
+        for (long long batch = 0; batch < num_batches; ++batch)
         {
-        case HemisphereMapping::Uniform:
-            kernel[i] = hemisphere_sample_uniform<T, P>(u, v);
-            break;
-        case HemisphereMapping::Cosine:
-            kernel[i] = hemisphere_sample_cos<T, P>(u, v);
-            break;
-        default:
-            break;
+            const auto first = static_cast<size_t>(batch) * engine_type::s_batch_size;
+            const auto count = std::min(engine_type::s_batch_size, size - first);
+
+            engine.inverses(first, count, v.data());
+            for (size_t i = 0; i < count; ++i)
+                kernel[first + i] = glm::tvec2<T, P>(static_cast<T>(first + i) / size, v[i]);
         }
     }
 }
 
-template <typename T, glm::precision P>
-void halton(tkernel<glm::tvec2<T, P>> & kernel, const unsigned int base1, const unsigned int base2)
+template <typename T, glm::precision P, typename Layout>
+void hammersley_sphere(tkernel<glm::tvec3<T, P>, Layout> & kernel, const HemisphereMapping type)
 {
-    #pragma omp parallel for
-    for (int i = 0; i < static_cast<int>(kernel.size()); ++i)
+    using engine_type = radical_inverse_engine<T>;
+
+    const auto size = kernel.size();
+    const auto engine = engine_type{ 2, size, true };
+
+    const auto num_batches = static_cast<long long>((size + engine_type::s_batch_size - 1) / engine_type::s_batch_size);
+
+    #pragma omp parallel
     {
-        const auto u = van_der_corput<T>(i, base1);
-        const auto v = van_der_corput<T>(i, base2);
-        kernel[i] = glm::tvec2<T, P>(u, v);
+        auto u = std::vector<T>(engine_type::s_batch_size);
+        auto cosines = std::vector<T>(engine_type::s_batch_size);
+        auto sines = std::vector<T>(engine_type::s_batch_size);
+
+        #pragma omp for
+        for (long long batch = 0; batch < num_batches; ++batch)
+        {
+            const auto first = static_cast<size_t>(batch) * engine_type::s_batch_size;
+            const auto count = std::min(engine_type::s_batch_size, size - first);
+
+            for (size_t i = 0; i < count; ++i)
+                u[i] = static_cast<T>(first + i) / size;
+            engine.sincos(first, count, cosines.data(), sines.data());
+
+            hemisphere_batch<T, P>(kernel, first, count, u.data(), cosines.data(), sines.data(), type);
+        }
     }
 }
 
-template <typename T, glm::precision P>
+template <typename T, glm::precision P, typename Layout>
+void halton(tkernel<glm::tvec2<T, P>, Layout> & kernel, const unsigned int base1, const unsigned int base2)
+{
+    using engine_type = radical_inverse_engine<T>;
+
+    const auto size = kernel.size();
+    const auto engine1 = engine_type{ base1, size, false };
+    const auto engine2 = engine_type{ base2, size, false };
+
+    const auto num_batches = static_cast<long long>((size + engine_type::s_batch_size - 1) / engine_type::s_batch_size);
+
+    #pragma omp parallel
+    {
+        auto u = std::vector<T>(engine_type::s_batch_size);
+        auto v = std::vector<T>(engine_type::s_batch_size);
+
+        #pragma omp for
+        for (long long batch = 0; batch < num_batches; ++batch)
+        {
+            const auto first = static_cast<size_t>(batch) * engine_type::s_batch_size;
+            const auto count = std::min(engine_type::s_batch_size, size - first);
+
+            engine1.inverses(first, count, u.data());
+            engine2.inverses(first, count, v.data());
+
+            for (size_t i = 0; i < count; ++i)
+                kernel[first + i] = glm::tvec2<T, P>(u[i], v[i]);
+        }
+    }
+}
+
+template <typename T, glm::precision P, typename Layout>
 void halton_sphere(
-    tkernel<glm::tvec3<T, P>> & kernel,
+    tkernel<glm::tvec3<T, P>, Layout> & kernel,
     const unsigned int base1,
     const unsigned int base2,
     const HemisphereMapping type)
 {
-    #pragma omp parallel for
-    for (int i = 0; i < static_cast<int>(kernel.size()); ++i)
+    using engine_type = radical_inverse_engine<T>;
+
+    const auto size = kernel.size();
+    const auto engine1 = engine_type{ base1, size, false };
+    const auto engine2 = engine_type{ base2, size, true };
+
+    const auto num_batches = static_cast<long long>((size + engine_type::s_batch_size - 1) / engine_type::s_batch_size);
+
+    #pragma omp parallel
     {
-        const auto u = van_der_corput<T>(i, base1);
-        const auto v = van_der_corput<T>(i, base2);
-        switch (type)
+        auto u = std::vector<T>(engine_type::s_batch_size);
+        auto cosines = std::vector<T>(engine_type::s_batch_size);
+        auto sines = std::vector<T>(engine_type::s_batch_size);
+
+        #pragma omp for
+        for (long long batch = 0; batch < num_batches; ++batch)
         {
-        case HemisphereMapping::Uniform:
-            kernel[i] = hemisphere_sample_uniform<T, P>(u, v);
-            break;
-        case HemisphereMapping::Cosine:
-            kernel[i] = hemisphere_sample_cos<T, P>(u, v);
-            break;
-        default:
-            break;
+            const auto first = static_cast<size_t>(batch) * engine_type::s_batch_size;
+            const auto count = std::min(engine_type::s_batch_size, size - first);
+
+            engine1.inverses(first, count, u.data());
+            engine2.sincos(first, count, cosines.data(), sines.data());
+
+            hemisphere_batch<T, P>(kernel, first, count, u.data(), cosines.data(), sines.data(), type);
         }
     }
 }
 
-template <typename T, glm::precision P>
-void best_candidate(tkernel<glm::tvec2<T, P>> & kernel, const unsigned int num_candidates)
+// uniform grid of accepted samples for nearest neighbor queries in best candidate sampling,
+// resolved to about one sample per cell once all samples are accepted
+
+template <typename V>
+class best_candidate_grid
 {
-    assert(num_candidates >= 1);
+public:
+    using value_type = typename V::value_type;
 
-    std::random_device RD;
-    std::mt19937_64 generator(RD());
-    std::uniform_real_distribution<> dist(0.0, 1.0);
+    best_candidate_grid(const size_t num_samples)
+    : m_none{ static_cast<size_t>(-1) }
+    , m_side{ std::max(static_cast<int>(std::ceil(std::pow(static_cast<double>(num_samples), 1.0 / V::length()))), 1) }
+    , m_cell_size{ static_cast<value_type>(1) / m_side }
+    {
+        auto num_cells = size_t{ 1 };
+        for (glm::length_t c = 0; c < V::length(); ++c)
+            num_cells *= static_cast<size_t>(m_side);
 
-    for (size_t k = 0; k < kernel.size(); ++k)
+        m_first.resize(num_cells, m_none);
+        m_next.reserve(num_samples);
+        m_samples.reserve(num_samples);
+    }
+
+    void insert(const V & sample)
     {
-        std::vector<glm::tvec2<T, P>> candidates(num_candidates);
-        std::vector<T> min_dists(num_candidates);
-        // generate candidates
-        #pragma omp parallel for
-        for (int c = 0; c < static_cast<int>(num_candidates); ++c)
+        const auto o = offset(cell(sample));
+
+        m_next.push_back(m_first[o]);
+        m_first[o] = m_samples.size();
+        m_samples.push_back(sample);
+    }
+
+    // squared distance of the probe to its nearest accepted sample (at most max_squared)
+    value_type nearest_squared(const V & probe, const value_type max_squared) const
+    {
+        const auto center = cell(probe);
+
+        // rings beyond this radius lie outside the grid
+        auto max_radius = 0;
+        for (glm::length_t c = 0; c < V::length(); ++c)
+            max_radius = std::max(max_radius, std::max(center[c], m_side - 1 - center[c]));
+
+        auto nearest = max_squared;
+        for (auto r = 0; r <= max_radius; ++r)
         {
-            candidates[c] = { dist(generator), dist(generator) };
+            visit_ring(probe, center, r, nearest);
 
-            // test candidates against previously accepted samples
-            T min_squared = 2;
-            for (size_t i = 0; i < k; ++i)
-            {
-                const T dist_squared = glm::length2(candidates[c] - kernel[i]);
-                min_squared = std::min(min_squared, dist_squared);
-            }
-            min_dists[c] = min_squared;
+            // samples in all further rings are at least r cells away
+            const auto bound = r * m_cell_size;
+            if (nearest <= bound * bound)
+                break;
         }
+        return nearest;
+    }
+
+protected:
+    using cell_type = glm::ivec3;
+
+    cell_type cell(const V & point) const
+    {
+        auto result = cell_type{ 0, 0, 0 };
+        for (glm::length_t c = 0; c < V::length(); ++c)
+            result[c] = glm::clamp(static_cast<int>(point[c] * m_side), 0, m_side - 1);
+
+        return result;
+    }
 
-        // find best candidate
-        T best_dist = min_dists[0];
-        unsigned int best_index = 0;
-        for (unsigned int c = 1; c < num_candidates; ++c)
+    size_t offset(const cell_type & cell) const
+    {
+        return (static_cast<size_t>(cell[2]) * m_side + cell[1]) * m_side + cell[0];
+    }
+
+    // tests all samples of the cells [x0, x1] in the given row
+    void visit_row(const V & probe, const int x0, const int x1, const int y, const int z, value_type & nearest) const
+    {
+        if (y < 0 || y >= m_side || z < 0 || z >= m_side)
+            return;
+
+        for (auto x = std::max(x0, 0); x <= std::min(x1, m_side - 1); ++x)
+            for (auto i = m_first[offset({ x, y, z })]; i != m_none; i = m_next[i])
+                nearest = std::min(nearest, glm::length2(probe - m_samples[i]));
+    }
+
+    // tests all samples of the cells at chebyshev distance r within the plane z
+    void visit_square(const V & probe, const cell_type & center, const int r, const int z, const bool filled, value_type & nearest) const
+    {
+        for (auto y = center[1] - r; y <= center[1] + r; ++y)
         {
-            if (min_dists[c] > best_dist)
+            if (filled || y == center[1] - r || y == center[1] + r)
             {
-                best_dist = min_dists[c];
-                best_index = c;
+                visit_row(probe, center[0] - r, center[0] + r, y, z, nearest);
+                continue;
             }
+            visit_row(probe, center[0] - r, center[0] - r, y, z, nearest);
+            if (r > 0)
+                visit_row(probe, center[0] + r, center[0] + r, y, z, nearest);
         }
+    }
 
-        kernel[k] = candidates[best_index];
+    template <typename T, glm::precision P>
+    void visit_ring(const glm::tvec2<T, P> & probe, const cell_type & center, const int r, value_type & nearest) const
+    {
+        visit_square(probe, center, r, 0, false, nearest);
     }
+
+    template <typename T, glm::precision P>
+    void visit_ring(const glm::tvec3<T, P> & probe, const cell_type & center, const int r, value_type & nearest) const
+    {
+        for (auto z = center[2] - r; z <= center[2] + r; ++z)
+            visit_square(probe, center, r, z, z == center[2] - r || z == center[2] + r, nearest);
+    }
+
+protected:
+    size_t m_none;
+
+    int m_side;
+    value_type m_cell_size;
+
+    std::vector<size_t> m_first; // per cell, index of the most recently accepted sample
+    std::vector<size_t> m_next;  // per sample, index of the previously accepted sample of the same cell
+    std::vector<V> m_samples;
+};
+
+template <typename T, glm::precision P>
+glm::tvec2<T, P> best_candidate_sample(random::philox_engine & generator, const glm::tvec2<T, P> &)
+{
+    return { random::uniform<T>(generator), random::uniform<T>(generator) };
 }
 
 template <typename T, glm::precision P>
-void best_candidate(tkernel<glm::tvec3<T, P>> & kernel, const unsigned int num_candidates)
+glm::tvec3<T, P> best_candidate_sample(random::philox_engine & generator, const glm::tvec3<T, P> &)
 {
+    return { random::uniform<T>(generator), random::uniform<T>(generator), random::uniform<T>(generator) };
+}
+
+template <typename V, typename Layout>
+void grid_best_candidate(tkernel<V, Layout> & kernel, const unsigned int num_candidates, const random::seed_type seed)
+{
+    using T = typename V::value_type;
+
     assert(num_candidates >= 1);
 
-    std::random_device RD;
-    std::mt19937_64 generator(RD());
-    std::uniform_real_distribution<> dist(0.0, 1.0);
+    // exceeds all squared distances within the unit square/cube
+    const auto max_squared = static_cast<T>(V::length());
+
+    auto grid = best_candidate_grid<V>{ kernel.size() };
+
+    std::vector<V> candidates(num_candidates);
+    std::vector<T> min_dists(num_candidates);
 
+    #pragma omp parallel
     for (size_t k = 0; k < kernel.size(); ++k)
     {
-        std::vector<glm::tvec3<T, P>> candidates(num_candidates);
-        std::vector<T> min_dists(num_candidates);
-        // generate candidates
-        #pragma omp parallel for
+        // generate candidates and test them against the nearest previously accepted sample
+        #pragma omp for
         for (int c = 0; c < static_cast<int>(num_candidates); ++c)
         {
-            candidates[c] = { dist(generator), dist(generator), dist(generator) };
-
-            // test candidates against previously accepted samples
-            T min_squared = 3;
-            for (size_t i = 0; i < k; ++i)
-            {
-                const T dist_squared = glm::length2(candidates[c] - kernel[i]);
-                min_squared = std::min(min_squared, dist_squared);
-            }
-            min_dists[c] = min_squared;
+            auto generator = random::philox_engine{ seed, k, static_cast<glm::uint32>(c) };
+            candidates[c] = best_candidate_sample(generator, V{ });
+            min_dists[c] = grid.nearest_squared(candidates[c], max_squared);
         }
 
-        // find best candidate
-        T best_dist = min_dists[0];
-        unsigned int best_index = 0;
-        for (unsigned int c = 1; c < num_candidates; ++c)
+        // find and accept best candidate
+        #pragma omp single
         {
-            if (min_dists[c] > best_dist)
+            T best_dist = min_dists[0];
+            unsigned int best_index = 0;
+            for (unsigned int c = 1; c < num_candidates; ++c)
             {
-                best_dist = min_dists[c];
-                best_index = c;
+                if (min_dists[c] > best_dist)
+                {
+                    best_dist = min_dists[c];
+                    best_index = c;
+                }
             }
-        }
 
-        kernel[k] = candidates[best_index];
+            kernel[k] = candidates[best_index];
+            grid.insert(candidates[best_index]);
+        }
     }
 }
 
-template <typename T, glm::precision P>
-void golden_point_set(tkernel<glm::tvec2<T, P>> & kernel)
+template <typename T, glm::precision P, typename Layout>
+void best_candidate(tkernel<glm::tvec2<T, P>, Layout> & kernel, const unsigned int num_candidates, const random::seed_type seed)
+{
+    grid_best_candidate(kernel, num_candidates, seed);
+}
+
+template <typename T, glm::precision P, typename Layout>
+void best_candidate(tkernel<glm::tvec3<T, P>, Layout> & kernel, const unsigned int num_candidates, const random::seed_type seed)
 {
-    std::random_device RD;
-    std::mt19937_64 generator(RD());
+    grid_best_candidate(kernel, num_candidates, seed);
+}
 
-    std::uniform_real_distribution<> rand_dist(0.0, 1.0);
+template <typename T, glm::precision P, typename Layout>
+void golden_point_set(tkernel<glm::tvec2<T, P>, Layout> & kernel, const random::seed_type seed)
+{
+    auto generator = random::philox_engine{ seed };
 
-    T x = rand_dist(generator);
+    T x = random::uniform<T>(generator);
 
     T min = x;
-    unsigned int idx = 0;
+    size_t idx = 0;
 
     // set the first coordinates
-    for (unsigned int i = 0; i < kernel.size(); ++i)
+    for (size_t i = 0; i < kernel.size(); ++i)
     {
-        auto& item = kernel[i];
-
-        item.y = x;
+        // whole values are written, as soa kernels provide proxy references only
+        kernel[i] = glm::tvec2<T, P>(0, x);
 
         if (x < min)
         {
@@ -632,13 +1115,13 @@ void golden_point_set(tkernel<glm::tvec2<T, P>> & kernel)
     }
 
     // find the first Fibonacci >= N
-    unsigned int f = 1;
-    unsigned int fp = 1;
+    size_t f = 1;
+    size_t fp = 1;
     unsigned int parity = 0;
 
     while(f + fp < kernel.size())
     {
-        unsigned int tmp = f;
+        size_t tmp = f;
         f += fp;
         fp = tmp;
 
@@ -646,8 +1129,8 @@ void golden_point_set(tkernel<glm::tvec2<T, P>> & kernel)
     }
 
     // set the increment and decrement
-    unsigned int inc = fp;
-    unsigned int dec = f;
+    size_t inc = fp;
+    size_t dec = f;
     
     if (parity & 1)
     {
@@ -656,9 +1139,9 @@ void golden_point_set(tkernel<glm::tvec2<T, P>> & kernel)
     }
 
     // permute the first coordinates
-    kernel[0].x = kernel[idx].y;
+    kernel[0] = glm::tvec2<T, P>(static_cast<glm::tvec2<T, P>>(kernel[idx]).y, static_cast<glm::tvec2<T, P>>(kernel[0]).y);
 
-    for (unsigned int i = 1; i < kernel.size(); ++i)
+    for (size_t i = 1; i < kernel.size(); ++i)
     {
         if (idx < dec)
         {
@@ -672,16 +1155,16 @@ void golden_point_set(tkernel<glm::tvec2<T, P>> & kernel)
             idx -= dec;
         }
 
-        kernel[i].x = kernel[idx].y;
+        kernel[i] = glm::tvec2<T, P>(static_cast<glm::tvec2<T, P>>(kernel[idx]).y, static_cast<glm::tvec2<T, P>>(kernel[i]).y);
     }
 
     // set the initial second coordinate
-    T y = rand_dist(generator);
+    T y = random::uniform<T>(generator);
 
     // set the second coordinates
-    for (unsigned int i = 0; i < kernel.size(); ++i)
+    for (size_t i = 0; i < kernel.size(); ++i)
     {
-        kernel[i].y = y;
+        kernel[i] = glm::tvec2<T, P>(static_cast<glm::tvec2<T, P>>(kernel[i]).x, y);
 
         // increment the coordinate by the inverted golden ratio
         y += 0.618033988749894;
@@ -693,6 +1176,192 @@ void golden_point_set(tkernel<glm::tvec2<T, P>> & kernel)
     }
 }
 
+namespace {
+
+// direction numbers of the first sobol_dimensions dimensions, taken from
+// "Constructing Sobol sequences with better two-dimensional projections"
+// by Joe and Kuo in 2008 (new-joe-kuo-6.21201)
+class sobol_directions
+{
+public:
+    static const glm::uint32 * get(unsigned int dimension);
+
+protected:
+    sobol_directions();
+
+    glm::uint32 m_directions[sobol_dimensions][32];
+};
+
+inline sobol_directions::sobol_directions()
+{
+    // degree s and coefficients a of the primitive polynomials as well as
+    // the initial direction numbers m, per dimension (except the first)
+    static const unsigned int degrees[sobol_dimensions - 1] = { 1, 2, 3, 3, 4, 4, 5, 5, 5, 5, 5, 5, 6, 6, 6 };
+    static const unsigned int coefficients[sobol_dimensions - 1] = { 0, 1, 1, 2, 1, 4, 2, 4, 7, 11, 13, 14, 1, 13, 16 };
+    static const unsigned int initials[sobol_dimensions - 1][6] = {
+        { 1 }, { 1, 3 }, { 1, 3, 1 }, { 1, 1, 1 }, { 1, 1, 3, 3 }, { 1, 3, 5, 13 },
+        { 1, 1, 5, 5, 17 }, { 1, 1, 5, 5, 5 }, { 1, 1, 7, 11, 19 }, { 1, 1, 5, 1, 1 },
+        { 1, 1, 1, 3, 11 }, { 1, 3, 5, 5, 31 }, { 1, 3, 3, 9, 7, 49 }, { 1, 1, 1, 15, 21, 21 },
+        { 1, 3, 1, 13, 27, 49 } };
+
+    // the first dimension is the van der Corput sequence in base 2
+    for (unsigned int j = 0; j < 32; ++j)
+        m_directions[0][j] = 1u << (31 - j);
+
+    for (unsigned int d = 1; d < sobol_dimensions; ++d)
+    {
+        const auto s = degrees[d - 1];
+        const auto a = coefficients[d - 1];
+        auto & v = m_directions[d];
+
+        for (unsigned int j = 0; j < s; ++j)
+            v[j] = initials[d - 1][j] << (31 - j);
+
+        // recurrence given by the primitive polynomial
+        for (unsigned int j = s; j < 32; ++j)
+        {
+            v[j] = v[j - s] ^ (v[j - s] >> s);
+            for (unsigned int k = 1; k < s; ++k)
+                v[j] ^= ((a >> (s - 1 - k)) & 1u) * v[j - k];
+        }
+    }
+}
+
+inline const glm::uint32 * sobol_directions::get(const unsigned int dimension)
+{
+    assert(dimension < sobol_dimensions);
+
+    static const sobol_directions directions;
+    return directions.m_directions[dimension];
+}
+
+// nested uniform scrambling by hashing, see "Practical Hash-based Owen
+// Scrambling" by Burley in 2020 (based on Laine and Karras, 2011)
+inline glm::uint32 owen_scramble(glm::uint32 bits, const glm::uint32 seed)
+{
+    bits = reverse_bits(bits);
+    bits += seed;
+    bits ^= bits * 0x6c50b47cu;
+    bits ^= bits * 0xb82f1e52u;
+    bits ^= bits * 0xc7afe638u;
+    bits ^= bits * 0x8d22f6e6u;
+    return reverse_bits(bits);
+}
+
+template <typename T>
+class sobol_operator
+{
+public:
+    sobol_operator(size_t size, glm::length_t coefficient, unsigned int first_dimension, bool scrambled, random::seed_type seed);
+
+    T operator()(const size_t index);
+
+protected:
+    const glm::uint32 * m_directions;
+    const bool m_scrambled;
+    glm::uint32 m_scramble_seed;
+
+    // previous point, for Gray code increments within a chunk
+    size_t m_index;
+    glm::uint32 m_bits;
+};
+
+
+template <typename T>
+sobol_operator<T>::sobol_operator(const size_t size, const glm::length_t coefficient
+    , const unsigned int first_dimension, const bool scrambled, const random::seed_type seed)
+: m_directions{ sobol_directions::get(first_dimension + static_cast<unsigned int>(coefficient)) }
+, m_scrambled{ scrambled }
+, m_scramble_seed{ 0u }
+, m_index{ std::numeric_limits<size_t>::max() }
+, m_bits{ 0u }
+{
+    assert(size <= (static_cast<glm::uint64>(1) << 32));
+    (void)size;
+
+    if (scrambled)
+    {
+        // every dimension is scrambled independently
+        auto generator = random::philox_engine{ seed, first_dimension + static_cast<glm::uint64>(coefficient), 0 };
+        m_scramble_seed = generator();
+    }
+}
+
+template <typename T>
+T sobol_operator<T>::operator()(const size_t index)
+{
+    if (index != 0 && index == m_index + 1)
+    {
+        // Gray code: successive points differ in the direction of the lowest set bit
+        auto bit = 0u;
+        while (((index >> bit) & 1u) == 0)
+            ++bit;
+
+        m_bits ^= m_directions[bit];
+    }
+    else
+    {
+        // direct computation for the first point of a chunk
+        const auto gray = static_cast<glm::uint32>(index ^ (index >> 1));
+
+        m_bits = 0u;
+        for (auto bit = 0u; bit < 32u; ++bit)
+            if ((gray >> bit) & 1u)
+                m_bits ^= m_directions[bit];
+    }
+    m_index = index;
+
+    const auto bits = m_scrambled ? owen_scramble(m_bits, m_scramble_seed) : m_bits;
+
+    // keep only as many bits as the mantissa holds, so that values stay below 1
+    static const auto precision = std::numeric_limits<T>::digits < 32 ? std::numeric_limits<T>::digits : 32;
+    return static_cast<T>(bits >> (32 - precision)) / static_cast<T>(static_cast<glm::uint64>(1) << precision);
+}
+
+} // anonymous namespace
+
+template <typename T, typename Layout, typename std::enable_if<std::is_floating_point<T>::value>::type *>
+void sobol(tkernel<T, Layout> & kernel, const bool scrambled, const random::seed_type seed, const unsigned int first_dimension)
+{
+    assert(first_dimension < sobol_dimensions);
+    kernel.template for_each<sobol_operator<T>>(first_dimension, scrambled, seed);
+}
+
+template <typename V, typename Layout, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type *>
+void sobol(tkernel<V, Layout> & kernel, const bool scrambled, const random::seed_type seed, const unsigned int first_dimension)
+{
+    assert(first_dimension + V::length() <= sobol_dimensions);
+    kernel.template for_each<sobol_operator<typename V::value_type>>(first_dimension, scrambled, seed);
+}
+
+template <typename Kernel>
+constexpr Kernel hammersley()
+{
+    static_assert(Kernel::length() == 2, "hammersley expects a kernel of two-component vectors");
+    return Kernel::generate(hammersley_generator<typename Kernel::component_type>{ Kernel::size() });
+}
+
+template <typename Kernel>
+constexpr Kernel halton(const unsigned int base1, const unsigned int base2)
+{
+    static_assert(Kernel::length() == 2, "halton expects a kernel of two-component vectors");
+    return Kernel::generate(halton_generator<typename Kernel::component_type>{ base1, base2 });
+}
+
+template <typename Kernel>
+constexpr Kernel hammersley_sphere(const HemisphereMapping type)
+{
+    static_assert(Kernel::length() == 3, "hammersley_sphere expects a kernel of three-component vectors");
+    return Kernel::generate(hammersley_sphere_generator<typename Kernel::component_type>{ Kernel::size(), type });
+}
+
+template <typename Kernel>
+constexpr Kernel halton_sphere(const unsigned int base1, const unsigned int base2, const HemisphereMapping type)
+{
+    static_assert(Kernel::length() == 3, "halton_sphere expects a kernel of three-component vectors");
+    return Kernel::generate(halton_sphere_generator<typename Kernel::component_type>{ base1, base2, type });
+}
+
 } // namespace sample
 
 
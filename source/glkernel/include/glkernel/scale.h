@@ -13,11 +13,19 @@ namespace glkernel
 namespace scale
 {
 
-template <typename T, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
-void range(tkernel<T> & kernel, T rangeToLower, T rangeToUpper, T rangeFromLower = 0, T rangeFromUpper = 1);
+template <typename T, typename Layout, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
+void range(tkernel<T, Layout> & kernel, T rangeToLower, T rangeToUpper, T rangeFromLower = 0, T rangeFromUpper = 1);
 
-template <typename V, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
-void range(tkernel<V> & kernel, typename V::value_type rangeToLower, typename V::value_type rangeToUpper, typename V::value_type rangeFromLower = 0, typename V::value_type rangeFromUpper = 1);
+template <typename V, typename Layout, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
+void range(tkernel<V, Layout> & kernel, typename V::value_type rangeToLower, typename V::value_type rangeToUpper, typename V::value_type rangeFromLower = 0, typename V::value_type rangeFromUpper = 1);
+
+// scales from the kernel's range over all components (see reduce::coefficient_minmax) to [rangeToLower, rangeToUpper];
+// a kernel of a single distinct value is set to rangeToLower
+template <typename T, typename Layout, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
+void normalize(tkernel<T, Layout> & kernel, T rangeToLower = 0, T rangeToUpper = 1);
+
+template <typename V, typename Layout, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
+void normalize(tkernel<V, Layout> & kernel, typename V::value_type rangeToLower = 0, typename V::value_type rangeToUpper = 1);
 
 
 } // namespace scale
@@ -4,6 +4,7 @@
 #include <glkernel/scale.h>
 
 #include <glkernel/glm_compatability.h>
+#include <glkernel/reduce.h>
 
 
 namespace glkernel
@@ -18,10 +19,10 @@ template <typename T>
 class range_operator
 {
 public:
-    range_operator(const glm::u16vec3 & extent, glm::length_t, T rangeToLower, T rangeToUpper, T rangeFromLower, T rangeFromUpper);
+    range_operator(const glm::u32vec3 & extent, glm::length_t, T rangeToLower, T rangeToUpper, T rangeFromLower, T rangeFromUpper);
 
     template <typename F, glm::precision P, template<typename, glm::precision> class V>
-    range_operator(const glm::u16vec3 & extent, glm::length_t coefficient, T rangeToLower, T rangeToUpper, T rangeFromLower, T rangeFromUpper);
+    range_operator(const glm::u32vec3 & extent, glm::length_t coefficient, T rangeToLower, T rangeToUpper, T rangeFromLower, T rangeFromUpper);
 
     T operator()(const T element);
 
@@ -33,7 +34,7 @@ protected:
 
 template<typename T>
 range_operator<T>::range_operator(
-    const glm::u16vec3 & /*extent*/, const glm::length_t /*coefficient*/,
+    const glm::u32vec3 & /*extent*/, const glm::length_t /*coefficient*/,
     T rangeToLower, T rangeToUpper, T rangeFromLower, T rangeFromUpper)
 : m_factor{ (rangeToUpper - rangeToLower) / (rangeFromUpper - rangeFromLower) }
 , m_summand{ rangeToLower - rangeFromLower * m_factor }
@@ -43,7 +44,7 @@ range_operator<T>::range_operator(
 template <typename T>
 template <typename F, glm::precision P, template<typename, glm::precision> class V>
 range_operator<T>::range_operator(
-    const glm::u16vec3 & extent, const glm::length_t coefficient,
+    const glm::u32vec3 & extent, const glm::length_t coefficient,
     T rangeToLower, T rangeToUpper, T rangeFromLower, T rangeFromUpper)
 : range_operator{ extent, coefficient, rangeToLower, rangeToUpper, rangeFromLower, rangeFromUpper}
 {
@@ -55,18 +56,50 @@ T range_operator<T>::operator()(const T element)
     return element * m_factor + m_summand;
 }
 
-template <typename T, typename std::enable_if<std::is_floating_point<T>::value>::type *>
-void range(tkernel<T> & kernel, T rangeToLower, T rangeToUpper, T rangeFromLower, T rangeFromUpper)
+template <typename T, typename Layout, typename std::enable_if<std::is_floating_point<T>::value>::type *>
+void range(tkernel<T, Layout> & kernel, T rangeToLower, T rangeToUpper, T rangeFromLower, T rangeFromUpper)
 {
     kernel.template for_each_element<range_operator<T>>(rangeToLower, rangeToUpper, rangeFromLower, rangeFromUpper);
 }
 
-template <typename V, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type *>
-void range(tkernel<V> & kernel, typename V::value_type rangeToLower, typename V::value_type rangeToUpper, typename V::value_type rangeFromLower, typename V::value_type rangeFromUpper)
+template <typename V, typename Layout, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type *>
+void range(tkernel<V, Layout> & kernel, typename V::value_type rangeToLower, typename V::value_type rangeToUpper, typename V::value_type rangeFromLower, typename V::value_type rangeFromUpper)
 {
     kernel.template for_each_element<range_operator<typename V::value_type>>(rangeToLower, rangeToUpper, rangeFromLower, rangeFromUpper);
 }
 
+template <typename T, typename Layout, typename std::enable_if<std::is_floating_point<T>::value>::type *>
+void normalize(tkernel<T, Layout> & kernel, T rangeToLower, T rangeToUpper)
+{
+    const auto rangeFrom = reduce::coefficient_minmax(kernel);
+    if (rangeFrom.second > rangeFrom.first)
+    {
+        range(kernel, rangeToLower, rangeToUpper, rangeFrom.first, rangeFrom.second);
+        return;
+    }
+
+    // a single distinct value has no extent to scale from
+    #pragma omp parallel for
+    for (long long i = 0; i < static_cast<long long>(kernel.size()); ++i)
+        kernel[static_cast<size_t>(i)] = rangeToLower;
+}
+
+template <typename V, typename Layout, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type *>
+void normalize(tkernel<V, Layout> & kernel, typename V::value_type rangeToLower, typename V::value_type rangeToUpper)
+{
+    const auto rangeFrom = reduce::coefficient_minmax(kernel);
+    if (rangeFrom.second > rangeFrom.first)
+    {
+        range(kernel, rangeToLower, rangeToUpper, rangeFrom.first, rangeFrom.second);
+        return;
+    }
+
+    // a single distinct value has no extent to scale from
+    #pragma omp parallel for
+    for (long long i = 0; i < static_cast<long long>(kernel.size()); ++i)
+        kernel[static_cast<size_t>(i)] = V(rangeToLower);
+}
+
 
 } // namespace scale
 
@@ -14,14 +14,18 @@ namespace sequence
 {
 
 
-template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
-void uniform(tkernel<T> & kernel, T range_min, T range_max);
+template<typename T, typename Layout, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
+void uniform(tkernel<T, Layout> & kernel, T range_min, T range_max);
 
-template<typename V, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
-void uniform(tkernel<V> & kernel, typename V::value_type range_min, typename V::value_type range_max);
+template<typename V, typename Layout, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
+void uniform(tkernel<V, Layout> & kernel, typename V::value_type range_min, typename V::value_type range_max);
 
-template<typename V, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
-void uniform(tkernel<V> & kernel, const V & range_min, const V & range_max);
+template<typename V, typename Layout, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type * = nullptr>
+void uniform(tkernel<V, Layout> & kernel, const V & range_min, const V & range_max);
+
+// compile-time sequence for static kernels, e.g., sequence::uniform<static_kernel1<16>>(0.f, 1.f)
+template <typename Kernel>
+constexpr Kernel uniform(typename Kernel::component_type range_min, typename Kernel::component_type range_max);
 
 
 } // namespace sequence
@@ -60,25 +60,47 @@ T uniform_operator<T>::operator()(const size_t index)
     return m_range_min + (m_range_max - m_range_min) * index / (m_size - 1);
 }
 
-template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type *>
-void uniform(tkernel<T> & kernel, const T range_min, const T range_max)
+template<typename T, typename Layout, typename std::enable_if<std::is_floating_point<T>::value>::type *>
+void uniform(tkernel<T, Layout> & kernel, const T range_min, const T range_max)
 {
     kernel.template for_each<uniform_operator<T>>(range_min, range_max);
 }
 
-template<typename V, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type *>
-void uniform(tkernel<V> & kernel, const typename V::value_type range_min, const typename V::value_type range_max)
+template<typename V, typename Layout, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type *>
+void uniform(tkernel<V, Layout> & kernel, const typename V::value_type range_min, const typename V::value_type range_max)
 {
     kernel.template for_each<uniform_operator<typename V::value_type>>(range_min, range_max);
 }
 
-template<typename V, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type *>
-void uniform(tkernel<V> & kernel, const V & range_min, const V & range_max)
+template<typename V, typename Layout, typename std::enable_if<std::is_floating_point<typename V::value_type>::value>::type *>
+void uniform(tkernel<V, Layout> & kernel, const V & range_min, const V & range_max)
 {
     kernel.template for_each<uniform_operator<typename V::value_type>>(range_min, range_max);
 }
 
 
+// provides the components of the compile-time uniform sequence
+template <typename T>
+struct uniform_generator
+{
+    constexpr T operator()(const size_t index, const glm::length_t) const
+    {
+        return m_range_min + (m_range_max - m_range_min) * index / (m_size - 1);
+    }
+
+    T m_range_min;
+    T m_range_max;
+
+    size_t m_size;
+};
+
+template <typename Kernel>
+constexpr Kernel uniform(const typename Kernel::component_type range_min, const typename Kernel::component_type range_max)
+{
+    static_assert(Kernel::size() > 1, "uniform sequence expects a kernel of more than one value");
+    return Kernel::generate(uniform_generator<typename Kernel::component_type>{ range_min, range_max, Kernel::size() });
+}
+
 } // namesapce sequence
 
 
@@ -1,9 +1,12 @@
 
 #pragma once
 
+#include <vector>
+
 #include <glm/gtc/type_precision.hpp>
 
 #include <glkernel/Kernel.h>
+#include <glkernel/random.h>
 
 
 namespace glkernel
@@ -14,21 +17,74 @@ namespace shuffle
 {
 
 
-template<typename T>
-void bucket_permutate(tkernel<T> & kernel
-    , glm::uint16 subkernel_width  = 1
-    , glm::uint16 subkernel_height = 1
-    , glm::uint16 subkernel_depth  = 1
-    , const bool permutate_per_bucket = false);
-
-// uses classic bayer matrices for kernel sizes 4, 9, 16, and 64 to remap the kernel
-// Note: kernel remains unchanged if its size is unsupported 
-template<typename T>
-void bayer(tkernel<T> & kernel);
-
-// uses std::random_shuffle
-template<typename T>
-void random(tkernel<T> & kernel, size_t start = 1);
+/**
+*  @brief
+*    Index mapping of bucket_permutate, computed once for an extent and
+*    applied to any number of kernels of that extent.
+*
+*    The kernel is divided into sub-kernels of the given extent; every
+*    sub-kernel receives one value of each bucket, a bucket being a
+*    contiguous range of size / subkernel size values. The mapping stores
+*    one 32 bit source index per value and the first index of every cycle,
+*    so it is applied in place without allocations.
+*/
+class permutation_plan
+{
+public:
+    permutation_plan(const glm::u32vec3 & extent
+        , const glm::u32vec3 & subkernel_extent
+        , bool permutate_per_bucket = false
+        , random::seed_type seed = random::nondeterministic_seed());
+
+    const glm::u32vec3 & extent() const;
+    size_t size() const;
+
+    // index of the value moved to the given index
+    glm::uint32 operator[](size_t index) const;
+
+    // parallel gather of the permutated source values into a destination (e.g., a view) of equal extent
+    template<typename T, typename SourceLayout, typename DestinationLayout>
+    void apply(const tkernel<T, SourceLayout> & source, tkernel<T, DestinationLayout> & destination) const;
+
+    // in place, following the cycles of the permutation in parallel
+    template<typename T, typename Layout>
+    void apply(tkernel<T, Layout> & kernel) const;
+
+protected:
+    glm::u32vec3 m_extent;
+
+    std::vector<glm::uint32> m_sources;
+    std::vector<glm::uint32> m_cycles;
+};
+
+// applies a permutation_plan computed for the kernel's extent (use the plan directly for multiple kernels)
+template<typename T, typename Layout>
+void bucket_permutate(tkernel<T, Layout> & kernel
+    , glm::uint32 subkernel_width  = 1
+    , glm::uint32 subkernel_height = 1
+    , glm::uint32 subkernel_depth  = 1
+    , const bool permutate_per_bucket = false
+    , random::seed_type seed = random::nondeterministic_seed());
+
+// remaps the kernel to an ordered dither matrix: the value of rank r (e.g., of a uniform sequence) is moved to
+// the position of rank r; uses classic bayer matrices for 2x2, 3x3, 4x4, and 8x8 kernels, and recursive bayer
+// matrices for any other power-of-two extent (including 3D, i.e., spatio-temporal, matrices)
+// Note: kernel remains unchanged if its extent is unsupported
+template<typename T, typename Layout>
+void bayer(tkernel<T, Layout> & kernel);
+
+// zero-based rank of a position within the recursive bayer matrix of the given power-of-two extent
+constexpr glm::uint32 bayer_rank(glm::uint32 x, glm::uint32 y, glm::uint32 z
+    , glm::uint32 width, glm::uint32 height = 1, glm::uint32 depth = 1);
+
+// compile-time variant for static kernels, returning the remapped kernel
+template<typename T, glm::uint32 W, glm::uint32 H, glm::uint32 D>
+constexpr static_tkernel<T, W, H, D> bayer(const static_tkernel<T, W, H, D> & kernel);
+
+// shuffles the values from start on in parallel (Fisher-Yates on blocks, merged by MergeShuffle);
+// the result depends on the seed only, not on the number of threads
+template<typename T, typename Layout>
+void random(tkernel<T, Layout> & kernel, size_t start = 1, random::seed_type seed = random::nondeterministic_seed());
 
 
 } // namespace shuffle
@@ -5,12 +5,7 @@
 
 #include <cassert>
 #include <vector>
-#include <set>
-#include <random>
 #include <algorithm>
-#include <array>
-#include <ctime>
-#include <memory>
 
 #include <glkernel/glm_compatability.h>
 
@@ -23,227 +18,430 @@ namespace shuffle
 {
 
 
-struct abstract_permutations
+inline permutation_plan::permutation_plan(const glm::u32vec3 & extent
+    , const glm::u32vec3 & subkernel_extent
+    , const bool permutate_per_bucket
+    , const random::seed_type seed)
+: m_extent{ extent }
+, m_sources(static_cast<size_t>(extent.x) * extent.y * extent.z)
 {
-    virtual size_t operator()(const size_t bucket, const size_t permutation) const = 0;
-    virtual ~abstract_permutations()
-{}
-};
+    assert(subkernel_extent.x > 0);
+    assert(subkernel_extent.y > 0);
+    assert(subkernel_extent.z > 0);
 
-struct unique_index_permutations : abstract_permutations
-{
-    unique_index_permutations(const int num_indices, const int num_permutations)
-    {
-        // create a vector that is to be permutated 
-        auto permutation = std::vector < size_t > { };
-        permutation.resize(num_indices);
-        for (int i = 0; i < num_indices; ++i)
-            permutation[i] = i;
-        const auto permutation_reset = permutation;
+    assert(subkernel_extent.x <= extent.x);
+    assert(subkernel_extent.y <= extent.y);
+    assert(subkernel_extent.z <= extent.z);
 
-        m_permutations.resize(num_permutations);
+    assert(extent.x % subkernel_extent.x == 0);
+    assert(extent.y % subkernel_extent.y == 0);
+    assert(extent.z % subkernel_extent.z == 0);
 
-        for (int i = 0; i < num_permutations; ++i)
-        {
-            std::random_shuffle(permutation.begin(), permutation.end());
-            m_permutations[i] = permutation;
-        }
-    }
+    // 32 bit indices
+    assert(m_sources.size() <= 0xffffffffu);
+
+    // the number of the elements required to fill a sub-kernel is the number of required buckets
+    const auto num_buckets = static_cast<size_t>(subkernel_extent.x) * subkernel_extent.y * subkernel_extent.z;
+    const auto size = m_sources.size();
+
+    if (num_buckets == 0 || size == 0)
+        return;
 
-    size_t operator()(const size_t bucket, const size_t permutation) const
+    // the number of sub-kernels is also the number of values per bucket
+    const auto num_subkernels = size / num_buckets;
+
+    // buckets are consecutive ranges of indices, each shuffled individually; the k-th sub-kernel
+    // receives the value at position num_subkernels - 1 - k of each bucket
+    auto buckets = std::vector<glm::uint32>(size);
+
+    #pragma omp parallel for
+    for (long long b = 0; b < static_cast<long long>(num_buckets); ++b)
     {
-        return m_permutations[bucket][permutation];
+        const auto first = buckets.begin() + b * num_subkernels;
+        for (size_t i = 0; i < num_subkernels; ++i)
+            first[i] = static_cast<glm::uint32>(b * num_subkernels + i);
+
+        auto generator = random::philox_engine{ seed, static_cast<glm::uint64>(b), 0 };
+        random::shuffle(first, first + num_subkernels, generator);
     }
 
-protected:
-    std::vector<std::vector<size_t>> m_permutations;
-};
+    const auto kw_over_w = static_cast<size_t>(extent.x) / subkernel_extent.x;
+    const auto kh_over_h = static_cast<size_t>(extent.y) / subkernel_extent.y;
 
-struct static_index_permutation : abstract_permutations
-{
-    static_index_permutation(const int num_indices)
-    {
-        m_permutation.resize(num_indices);
-        for (int i = 0; i < num_indices; ++i)
-            m_permutation[i] = i;
+    const auto w_step = static_cast<size_t>(subkernel_extent.x);
+    const auto h_step = static_cast<size_t>(subkernel_extent.y) * extent.x;
+    const auto d_step = static_cast<size_t>(subkernel_extent.z) * extent.x * extent.y;
+
+    // permutation of the buckets among the values of a sub-kernel: a single one, or one per sub-kernel
+    auto permutation = std::vector<glm::uint32>(num_buckets);
+    for (size_t i = 0; i < num_buckets; ++i)
+        permutation[i] = static_cast<glm::uint32>(i);
 
-        std::random_shuffle(m_permutation.begin(), m_permutation.end());
+    if (!permutate_per_bucket)
+    {
+        auto generator = random::philox_engine{ seed, 0, 1 };
+        random::shuffle(permutation.begin(), permutation.end(), generator);
     }
 
-    size_t operator()(const size_t, const size_t permutation) const
+    #pragma omp parallel firstprivate(permutation)
     {
-        return m_permutation[permutation];
+        #pragma omp for
+        for (long long k = 0; k < static_cast<long long>(num_subkernels); ++k)
+        {
+            const auto subkernel = static_cast<size_t>(k);
+
+            if (permutate_per_bucket)
+            {
+                for (size_t i = 0; i < num_buckets; ++i)
+                    permutation[i] = static_cast<glm::uint32>(i);
+
+                auto generator = random::philox_engine{ seed, subkernel, 1 };
+                random::shuffle(permutation.begin(), permutation.end(), generator);
+            }
+
+            const auto offset = w_step * (subkernel % kw_over_w)
+                + h_step * ((subkernel / kw_over_w) % kh_over_h) + d_step * (subkernel / (kw_over_w * kh_over_h));
+
+            const auto position = num_subkernels - 1 - subkernel;
+
+            auto i = size_t{ 0 };
+            for (size_t d = 0; d < subkernel_extent.z; ++d)
+            for (size_t h = 0; h < subkernel_extent.y; ++h)
+            for (size_t w = 0; w < subkernel_extent.x; ++w)
+            {
+                const auto index = offset + d * extent.x * extent.y + h * extent.x + w;
+                m_sources[index] = buckets[permutation[i++] * num_subkernels + position];
+            }
+        }
     }
 
-protected:
-    std::vector<size_t> m_permutation;
-};
+    // first index of every cycle (of length > 1), for applying the permutation in place
+    auto visited = std::vector<bool>(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (visited[i] || m_sources[i] == i)
+            continue;
 
+        m_cycles.push_back(static_cast<glm::uint32>(i));
+        for (auto j = i; !visited[j]; j = m_sources[j])
+            visited[j] = true;
+    }
+}
 
-template<typename T>
-void bucket_permutate(tkernel<T> & kernel
-    , const glm::uint16 subkernel_width
-    , const glm::uint16 subkernel_height
-    , const glm::uint16 subkernel_depth
-    , const bool permutate_per_bucket)
+inline const glm::u32vec3 & permutation_plan::extent() const
 {
-    assert(subkernel_width  > 0);
-    assert(subkernel_height > 0);
-    assert(subkernel_depth  > 0);
+    return m_extent;
+}
 
-    assert(subkernel_width  <= kernel.width());
-    assert(subkernel_height <= kernel.height());
-    assert(subkernel_depth  <= kernel.depth());
+inline size_t permutation_plan::size() const
+{
+    return m_sources.size();
+}
 
-    assert(kernel.width()  % subkernel_width  == 0);
-    assert(kernel.height() % subkernel_height == 0);
-    assert(kernel.depth()  % subkernel_depth  == 0);
+inline glm::uint32 permutation_plan::operator[](const size_t index) const
+{
+    return m_sources[index];
+}
 
-    // the number of the elements required to fill a sub-kernel is the number of required buckets
-    const auto num_buckets = subkernel_width * subkernel_height * subkernel_depth;
-    assert(kernel.size() % num_buckets == 0);
+template<typename T, typename SourceLayout, typename DestinationLayout>
+void permutation_plan::apply(const tkernel<T, SourceLayout> & source, tkernel<T, DestinationLayout> & destination) const
+{
+    assert(source.extent() == m_extent);
+    assert(destination.extent() == m_extent);
 
-    if (num_buckets == 0)
-        return;
+    const auto size = static_cast<long long>(m_sources.size());
 
-    std::srand(static_cast<unsigned int>(std::time(0)));
+    #pragma omp parallel for
+    for (long long i = 0; i < size; ++i)
+        destination[static_cast<size_t>(i)] = static_cast<T>(source[m_sources[static_cast<size_t>(i)]]);
+}
 
-    // the number of sub-kernels is also the number of values per bucket
-    const auto num_subkernels = static_cast<int>(kernel.size() / num_buckets);
+template<typename T, typename Layout>
+void permutation_plan::apply(tkernel<T, Layout> & kernel) const
+{
+    assert(kernel.extent() == m_extent);
 
-    // create buckets by sequentially adding every kernel index and shuffling every
-    // bucket individually to "randomly" pop back from later on ...
-    auto buckets = std::vector<std::vector<size_t>>{ };
-    buckets.resize(num_buckets);
+    const auto num_cycles = static_cast<long long>(m_cycles.size());
 
-    auto index = 0;
-    for (size_t b = 0; b < buckets.size(); ++b)
+    // cycles are disjoint, so they can be rotated concurrently
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (long long c = 0; c < num_cycles; ++c)
     {
-        for (int i = 0; i < num_subkernels; ++i)
-            buckets[b].push_back(index++);
+        const auto first = static_cast<size_t>(m_cycles[static_cast<size_t>(c)]);
+        const auto value = static_cast<T>(kernel[first]);
 
-        std::random_shuffle(buckets[b].begin(), buckets[b].end());
+        auto i = first;
+        for (auto j = static_cast<size_t>(m_sources[i]); j != first; j = m_sources[i])
+        {
+            kernel[i] = static_cast<T>(kernel[j]);
+            i = j;
+        }
+        kernel[i] = value;
     }
+}
 
-    // use permutations to pop the last item of each bucket, while 
-    // selecting the bucket based on the subkernels permutation ...
 
-    auto subkernel_indices = std::vector<size_t>{ };
-    subkernel_indices.resize(num_buckets);
+template<typename T, typename Layout>
+void bucket_permutate(tkernel<T, Layout> & kernel
+    , const glm::uint32 subkernel_width
+    , const glm::uint32 subkernel_height
+    , const glm::uint32 subkernel_depth
+    , const bool permutate_per_bucket
+    , const random::seed_type seed)
+{
+    const auto plan = permutation_plan{ kernel.extent()
+        , glm::u32vec3(subkernel_width, subkernel_height, subkernel_depth), permutate_per_bucket, seed };
 
-    // a copy of the given kernel is used to read and reassign values from
-    const auto read_kernel = kernel;
+    plan.apply(kernel);
+}
 
-    const auto kw_over_w = kernel.width()  / subkernel_width;
-    const auto kh_over_h = kernel.height() / subkernel_height;
 
-    const auto w_step = subkernel_width;
-    const auto h_step = subkernel_height * kernel.width();
-    const auto d_step = subkernel_depth  * kernel.width() * kernel.height();
 
 
-    // create permutations (or use single, static permutation)
-    std::unique_ptr<abstract_permutations> permutations;
-    if (permutate_per_bucket)
-        permutations.reset(new unique_index_permutations{ num_buckets, num_subkernels });
-    else
-        permutations.reset(new static_index_permutation{ num_buckets });
+namespace
+{
 
+// one-based bayer matrices of 2x2, 3x3, 4x4, and 8x8 values
+
+constexpr size_t bayer2[] = {
+     1,  3,
+     4,  2 };
+
+constexpr size_t bayer3[] = {
+     3,  7,  4,
+     6,  1,  9,
+     2,  8,  5 };
+
+constexpr size_t bayer4[] = {
+     1,  9,  3, 11,
+    13,  5, 15,  7,
+     4, 12,  2, 10,
+    16,  8, 14,  6 };
+
+constexpr size_t bayer8[] = {
+     1, 49, 13, 61,  4, 52, 16, 64,
+    33, 17, 45, 29, 36, 20, 48, 32,
+     9, 57,  5, 53, 12, 60,  8, 56,
+    41, 25, 37, 21, 44, 28, 40, 24,
+     3, 51, 15, 63,  2, 50, 14, 62,
+    35, 19, 47, 31, 34, 18, 46, 30,
+    11, 59,  7, 55, 10, 58,  6, 54,
+    43, 27, 39, 23, 42, 26, 38, 22 };
+
+constexpr bool is_power_of_two(const glm::uint32 value)
+{
+    return value > 0 && (value & (value - 1)) == 0;
+}
 
-    for (int k = 0; k < num_subkernels; ++k)
-    {
-        const auto offset = w_step * (k % kw_over_w) 
-            + h_step * ((k / kw_over_w) % kh_over_h) + d_step * (k / (kw_over_w * kh_over_h));
+// the classic matrices are used for their exact 2D extents only
+constexpr bool bayer_classic(const glm::uint32 width, const glm::uint32 height, const glm::uint32 depth, const glm::uint32 extent)
+{
+    return width == extent && height == extent && depth == 1;
+}
 
-        // retrieve indices to map subkernel indices to the given kernel
-        auto i = 0;
-        for (int d = 0; d < subkernel_depth;  ++d)
-        for (int h = 0; h < subkernel_height; ++h)
-        for (int w = 0; w < subkernel_width; ++w)
-            subkernel_indices[i++] = offset + d * kernel.width() * kernel.height() + h * kernel.width() + w;
+// other extents need to be powers of two in every dimension
+constexpr bool bayer_supported(const glm::uint32 width, const glm::uint32 height, const glm::uint32 depth)
+{
+    return bayer_classic(width, height, depth, 3)
+        || (is_power_of_two(width) && is_power_of_two(height) && is_power_of_two(depth));
+}
 
-        for (int i_permutation = 0; i_permutation < num_buckets; ++i_permutation)
-        {
-            const auto i_bucket = (*permutations)(k, i_permutation);
-            const auto i_read   = buckets[i_bucket].back();
-            const auto i_kernel = subkernel_indices[i_permutation];
+// appends the lowest coordinate bit of an axis to the packed bits, if the axis is not yet resolved
+constexpr glm::uint32 bayer_pack(const glm::uint32 packed, const glm::uint32 extent, const glm::uint32 coordinate)
+{
+    return extent > 1 ? (packed << 1) | (coordinate & 1u) : packed;
+}
+
+constexpr glm::uint32 bayer_axes(const glm::uint32 width, const glm::uint32 height, const glm::uint32 depth)
+{
+    return (width > 1 ? 1u : 0u) + (height > 1 ? 1u : 0u) + (depth > 1 ? 1u : 0u);
+}
 
-            kernel[i_kernel] = read_kernel[i_read];
+// digit of a 2x2(x2) level: for packed bits c_0..c_n-1 (x first), the lowest digit bit is c_n-1 and
+// every further bit is the xor of two neighbouring axes' bits, i.e., consecutive ranks are antipodal
+constexpr glm::uint32 bayer_digit(const glm::uint32 packed, const glm::uint32 axes)
+{
+    return (packed ^ (packed << 1)) & ((1u << axes) - 1u);
+}
 
-            buckets[i_bucket].pop_back();
-        }
-    }
+// rank of the position within the ordered dither matrix, the finest level being the most significant digit
+// (the closed form of the recursive Bayer construction, i.e., bit-reversed interleaved coordinates)
+constexpr glm::uint32 bayer_levels(const glm::uint32 x, const glm::uint32 y, const glm::uint32 z
+    , const glm::uint32 width, const glm::uint32 height, const glm::uint32 depth, const glm::uint32 rank)
+{
+    return bayer_axes(width, height, depth) == 0 ? rank
+        : bayer_levels(x >> 1, y >> 1, z >> 1, (width + 1) >> 1, (height + 1) >> 1, (depth + 1) >> 1
+            , (rank << bayer_axes(width, height, depth))
+                | bayer_digit(bayer_pack(bayer_pack(bayer_pack(0u, width, x), height, y), depth, z), bayer_axes(width, height, depth)));
+}
+
+// index of the value to be read for the given index (identity for unsupported extents)
+constexpr size_t bayer_index(const glm::uint32 width, const glm::uint32 height, const glm::uint32 depth, const size_t index)
+{
+    return bayer_classic(width, height, depth, 2) ? bayer2[index] - 1
+        :  bayer_classic(width, height, depth, 3) ? bayer3[index] - 1
+        :  bayer_classic(width, height, depth, 4) ? bayer4[index] - 1
+        :  bayer_classic(width, height, depth, 8) ? bayer8[index] - 1
+        :  bayer_supported(width, height, depth) ? bayer_levels(static_cast<glm::uint32>(index % width)
+            , static_cast<glm::uint32>(index / width % height), static_cast<glm::uint32>(index / width / height)
+            , width, height, depth, 0u)
+        :  index;
 }
 
+template<typename Kernel>
+struct bayer_generator
+{
+    constexpr typename Kernel::component_type operator()(const size_t index, const glm::length_t coefficient) const
+    {
+        return m_kernel.component(bayer_index(Kernel::width(), Kernel::height(), Kernel::depth(), index), coefficient);
+    }
 
+    Kernel m_kernel;
+};
 
+// number of values shuffled sequentially by random (Fisher-Yates) before merging
+constexpr size_t s_shuffle_block_size = 1 << 16;
 
-template<typename T>
-void bayer(tkernel<T> & kernel)
+// swaps two values, written as a whole since soa kernels provide proxy references only
+template<typename T, typename Layout>
+void swap_values(tkernel<T, Layout> & kernel, const size_t a, const size_t b)
 {
-    static const auto bayer2 = std::array<size_t, 4>({ {
-         1,  3,
-         4,  2 } });
+    const T value = kernel[a];
+    kernel[a] = static_cast<T>(kernel[b]);
+    kernel[b] = value;
+}
 
-    static const auto bayer3 = std::array<size_t, 9>({ {
-         3,  7,  4,
-         6,  1,  9, 
-         2,  8,  5 } });
+// Fisher-Yates shuffle of the values [first, last), drawing the same numbers as random::shuffle
+template<typename T, typename Layout>
+void shuffle_values(tkernel<T, Layout> & kernel, const size_t first, const size_t last, random::philox_engine & engine)
+{
+    for (auto i = last - first; i > 1; --i)
+    {
+        const auto j = random::bounded(engine, static_cast<glm::uint32>(i));
+        swap_values(kernel, first + i - 1, first + j);
+    }
+}
 
-    static const auto bayer4 = std::array<size_t, 16>({ {
-         1,  9,  3, 11,
-        13,  5, 15,  7,
-         4, 12,  2, 10,
-        16,  8, 14,  6 } });
+// merges two shuffled ranges into one shuffled range, see "MergeShuffle: A Very Fast, Parallel
+// Random Permutation Algorithm" by Bacher et al. in 2015
+template<typename T, typename Layout>
+void merge_shuffled(tkernel<T, Layout> & kernel, const size_t first, const size_t middle, const size_t last, random::philox_engine & engine)
+{
+    auto i = first;
+    auto j = middle;
 
-    static const auto bayer8 = std::array<size_t, 64>({ {
-         1, 49, 13, 61,  4, 52, 16, 64,
-        33, 17, 45, 29, 36, 20, 48, 32, 
-         9, 57,  5, 53, 12, 60,  8, 56, 
-        41, 25, 37, 21, 44, 28, 40, 24, 
-         3, 51, 15, 63,  2, 50, 14, 62, 
-        35, 19, 47, 31, 34, 18, 46, 30, 
-        11, 59,  7, 55, 10, 58,  6, 54, 
-        43, 27, 39, 23, 42, 26, 38, 22 } });
+    // interleave both ranges by coin flips until one of them is exhausted
+    auto bits = glm::uint32{ 0 };
+    auto num_bits = 0;
+    for (;;)
+    {
+        if (num_bits == 0)
+        {
+            bits = engine();
+            num_bits = 32;
+        }
 
-    const auto size = kernel.size();
-    if (size != 4 && size != 9 && size != 16 && size != 64)
-        return;
+        const auto flip = bits & 1u;
+        bits >>= 1u;
+        --num_bits;
+
+        if (flip ? j == last : i == j)
+            break;
 
-    // a copy of the given kernel is used to read and reassign values from
-    const auto read_kernel = kernel;
+        // branchless on the flip: a value of the second range is swapped in, or the value stays
+        swap_values(kernel, i, flip ? j : i);
+        j += flip;
+        ++i;
+    }
 
-    switch (kernel.size())
+    // insert the remaining values at uniform positions (Fisher-Yates)
+    for (; i != last; ++i)
     {
-    case  4:
-        for (size_t i = 0; i <  4; ++i)
-            kernel[i] = read_kernel[bayer2[i] - 1];
-        break;
-
-    case  9:
-        for (size_t i = 0; i < 9; ++i)
-            kernel[i] = read_kernel[bayer3[i] - 1];
-        break;
-
-    case 16:
-        for (size_t i = 0; i < 16; ++i)
-            kernel[i] = read_kernel[bayer4[i] - 1];
-        break;
-
-    case 64:
-        for (size_t i = 0; i < 64; ++i)
-            kernel[i] = read_kernel[bayer8[i] - 1];
-        break;
-    default:
-        break;
+        const auto k = random::bounded(engine, static_cast<glm::uint32>(i - first + 1));
+        swap_values(kernel, i, first + k);
     }
 }
 
-template<typename T>
-void random(tkernel<T> & kernel, size_t start)
+} // anonymous namespace
+
+template<typename T, typename Layout>
+void bayer(tkernel<T, Layout> & kernel)
+{
+    const auto width = kernel.width();
+    const auto height = kernel.height();
+    const auto depth = kernel.depth();
+    if (!bayer_supported(width, height, depth))
+        return;
+
+    const auto size = static_cast<long long>(kernel.size());
+
+    // a copy of the given kernel's values is used to read and reassign values from
+    auto read_kernel = std::vector<T>(kernel.size());
+
+    #pragma omp parallel for
+    for (long long i = 0; i < size; ++i)
+        read_kernel[static_cast<size_t>(i)] = kernel[static_cast<size_t>(i)];
+
+    // every rank is computed independently
+    #pragma omp parallel for
+    for (long long i = 0; i < size; ++i)
+        kernel[static_cast<size_t>(i)] = read_kernel[bayer_index(width, height, depth, static_cast<size_t>(i))];
+}
+
+constexpr glm::uint32 bayer_rank(const glm::uint32 x, const glm::uint32 y, const glm::uint32 z
+    , const glm::uint32 width, const glm::uint32 height, const glm::uint32 depth)
+{
+    return bayer_levels(x, y, z, width, height, depth, 0u);
+}
+
+template<typename T, glm::uint32 W, glm::uint32 H, glm::uint32 D>
+constexpr static_tkernel<T, W, H, D> bayer(const static_tkernel<T, W, H, D> & kernel)
+{
+    return static_tkernel<T, W, H, D>::generate(bayer_generator<static_tkernel<T, W, H, D>>{ kernel });
+}
+
+template<typename T, typename Layout>
+void random(tkernel<T, Layout> & kernel, const size_t start, const random::seed_type seed)
 {
     assert(start < kernel.size());
-    std::random_shuffle(kernel.begin() + start, kernel.end());
+
+    const auto size = kernel.size() - start;
+
+    // blocks are shuffled independently and merged pairwise (MergeShuffle), with a fixed block
+    // size so that the result depends on the seed only, not on the number of threads
+    const auto num_blocks = (size + s_shuffle_block_size - 1) / s_shuffle_block_size;
+
+    #pragma omp parallel for
+    for (long long b = 0; b < static_cast<long long>(num_blocks); ++b)
+    {
+        const auto block = static_cast<size_t>(b);
+        const auto block_first = start + block * s_shuffle_block_size;
+        const auto block_size = std::min(s_shuffle_block_size, size - block * s_shuffle_block_size);
+
+        auto generator = random::philox_engine{ seed, block, 0 };
+        shuffle_values(kernel, block_first, block_first + block_size, generator);
+    }
+
+    auto level = glm::uint32{ 1 };
+    for (auto merged_size = s_shuffle_block_size; merged_size < size; merged_size *= 2, ++level)
+    {
+        const auto num_merges = (size + 2 * merged_size - 1) / (2 * merged_size);
+
+        #pragma omp parallel for
+        for (long long m = 0; m < static_cast<long long>(num_merges); ++m)
+        {
+            const auto merge = static_cast<size_t>(m);
+            const auto merge_first = merge * 2 * merged_size;
+            const auto middle = merge_first + merged_size;
+
+            // a trailing block without partner remains as is
+            if (middle >= size)
+                continue;
+
+            auto generator = random::philox_engine{ seed, merge, level };
+            merge_shuffled(kernel, start + merge_first, start + middle, start + std::min(middle + merged_size, size), generator);
+        }
+    }
 }
 
 
@@ -1,6 +1,9 @@
 
 #pragma once
 
+#include <type_traits>
+#include <vector>
+
 #include <glm/gtc/type_precision.hpp>
 
 #include <glkernel/Kernel.h>
@@ -14,8 +17,82 @@ namespace sort
 {
 
 
-template <typename T>
-void distance(tkernel<T> & kernel, const T & origin);
+// sorts the values by ascending distance to origin (values of equal distance keep their order),
+// computing squared distances once and sorting them by a parallel radix sort
+template <typename T, typename Layout>
+void distance(tkernel<T, Layout> & kernel, const T & origin);
+
+// sorts the values by ascending keys (values of equal keys keep their order), the keys being either
+// extracted from the values or given by a companion kernel of equal size, by a parallel radix sort;
+// returns the permutation, i.e., the original index of the value at each index (see reorder)
+template <typename T, typename Layout, typename KeyExtractor>
+std::vector<glm::uint32> by_key(tkernel<T, Layout> & kernel, const KeyExtractor & extractor);
+
+template <typename T, typename Layout, typename K, typename KeyLayout>
+std::vector<glm::uint32> by_key(tkernel<T, Layout> & kernel, const tkernel<K, KeyLayout> & keys);
+
+// reorders the values of a (companion) kernel by a permutation as returned by by_key
+template <typename T, typename Layout>
+void reorder(tkernel<T, Layout> & kernel, const std::vector<glm::uint32> & permutation);
+
+
+// key extractors for by_key, returning floating point values or unsigned integers
+
+// index of the value's cell along a Z-order (Morton) curve, the cells subdividing [lower, upper]
+// into 2^16 cells per axis for 2D and 2^21 cells per axis for 3D values
+template <typename V>
+struct morton
+{
+    using key_type = typename std::conditional<V::length() == 2, glm::uint32, glm::uint64>::type;
+
+    morton(const V & lower = V(0), const V & upper = V(1));
+
+    key_type operator()(const V & value) const;
+
+protected:
+    V m_lower;
+    V m_scale;
+};
+
+// index of the value's cell along a Hilbert curve, with cells as for morton (consecutive cells
+// are adjacent, i.e., a better locality than the Z-order at a slightly higher cost)
+template <typename V>
+struct hilbert
+{
+    using key_type = typename std::conditional<V::length() == 2, glm::uint32, glm::uint64>::type;
+
+    hilbert(const V & lower = V(0), const V & upper = V(1));
+
+    key_type operator()(const V & value) const;
+
+protected:
+    V m_lower;
+    V m_scale;
+};
+
+// polar angle of the value's first two coordinates around the origin, within [-pi, pi]
+template <typename V>
+struct angle
+{
+    angle(const V & origin = V(0));
+
+    typename V::value_type operator()(const V & value) const;
+
+protected:
+    V m_origin;
+};
+
+// projection of the value onto an axis, e.g., luminance for weights of color channels
+template <typename V>
+struct projection
+{
+    projection(const V & axis);
+
+    typename kernel_component<V>::type operator()(const V & value) const;
+
+protected:
+    V m_axis;
+};
 
 
 } // namespace sort
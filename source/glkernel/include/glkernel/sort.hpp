@@ -4,6 +4,13 @@
 #include <glkernel/sort.h>
 
 #include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <glm/geometric.hpp>
 
 #include <glkernel/glm_compatability.h>
 
@@ -16,28 +23,333 @@ namespace sort
 {
 
 
-template <typename T>
-struct distance_comparator
+namespace
+{
+
+// unsigned integer keys ordered like the given floating point values (negative values included)
+inline glm::uint32 radix_key(const float value)
+{
+    auto bits = glm::uint32{ 0 };
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits ^ ((bits >> 31u) != 0u ? 0xffffffffu : 0x80000000u);
+}
+
+inline glm::uint64 radix_key(const double value)
+{
+    auto bits = glm::uint64{ 0 };
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits ^ ((bits >> 63u) != 0u ? 0xffffffffffffffffull : 0x8000000000000000ull);
+}
+
+inline glm::uint32 radix_key(const glm::uint32 value)
+{
+    return value;
+}
+
+inline glm::uint64 radix_key(const glm::uint64 value)
+{
+    return value;
+}
+
+// number of keys histogrammed and scattered by a single thread per pass
+constexpr size_t s_radix_chunk_size = 1 << 16;
+
+// stable LSD radix sort of keys along with their indices, 8 bits per pass with chunks processed in
+// parallel, skipping passes of digits common to all keys
+template <typename Key>
+void radix_sort(std::vector<Key> & keys, std::vector<glm::uint32> & indices)
+{
+    assert(keys.size() == indices.size());
+
+    const auto size = keys.size();
+    const auto num_chunks = (size + s_radix_chunk_size - 1) / s_radix_chunk_size;
+
+    auto sorted_keys = std::vector<Key>(size);
+    auto sorted_indices = std::vector<glm::uint32>(size);
+
+    // per chunk (row) and digit (column): the number of keys, turned into the first target index
+    auto offsets = std::vector<size_t>(num_chunks * 256);
+
+    for (auto shift = 0u; shift < sizeof(Key) * 8u; shift += 8u)
+    {
+        #pragma omp parallel for
+        for (long long c = 0; c < static_cast<long long>(num_chunks); ++c)
+        {
+            const auto chunk = static_cast<size_t>(c);
+            const auto counts = offsets.begin() + chunk * 256;
+            std::fill(counts, counts + 256, size_t{ 0 });
+
+            const auto last = std::min((chunk + 1) * s_radix_chunk_size, size);
+            for (auto i = chunk * s_radix_chunk_size; i < last; ++i)
+                ++counts[static_cast<size_t>(keys[i] >> shift) & 0xffu];
+        }
+
+        auto common = false;
+        for (size_t digit = 0; digit < 256 && !common; ++digit)
+        {
+            auto count = size_t{ 0 };
+            for (size_t chunk = 0; chunk < num_chunks; ++chunk)
+                count += offsets[chunk * 256 + digit];
+            common = count == size;
+        }
+        if (common)
+            continue;
+
+        // digit-major, chunk-minor exclusive prefix sum, i.e., keys of equal digits keep their order
+        auto sum = size_t{ 0 };
+        for (size_t digit = 0; digit < 256; ++digit)
+        for (size_t chunk = 0; chunk < num_chunks; ++chunk)
+        {
+            const auto count = offsets[chunk * 256 + digit];
+            offsets[chunk * 256 + digit] = sum;
+            sum += count;
+        }
+
+        #pragma omp parallel for
+        for (long long c = 0; c < static_cast<long long>(num_chunks); ++c)
+        {
+            const auto chunk = static_cast<size_t>(c);
+            const auto targets = offsets.begin() + chunk * 256;
+
+            const auto last = std::min((chunk + 1) * s_radix_chunk_size, size);
+            for (auto i = chunk * s_radix_chunk_size; i < last; ++i)
+            {
+                const auto target = targets[static_cast<size_t>(keys[i] >> shift) & 0xffu]++;
+                sorted_keys[target] = keys[i];
+                sorted_indices[target] = indices[i];
+            }
+        }
+
+        keys.swap(sorted_keys);
+        indices.swap(sorted_indices);
+    }
+}
+
+// sorts the values by the keys returned by key(index, value) for each value, returns the permutation
+template <typename T, typename Layout, typename KeyFunction>
+std::vector<glm::uint32> sort_by(tkernel<T, Layout> & kernel, const KeyFunction & key)
 {
-    distance_comparator(const T & origin)
-    : m_origin {origin}
+    using key_type = decltype(radix_key(key(size_t{ 0 }, std::declval<const T &>())));
+
+    const auto size = kernel.size();
+    assert(size <= 0xffffffffu);
+
+    auto keys = std::vector<key_type>(size);
+    auto indices = std::vector<glm::uint32>(size);
+    auto values = std::vector<T>(size);
+
+    // keys are computed once per value
+    #pragma omp parallel for
+    for (long long i = 0; i < static_cast<long long>(size); ++i)
     {
+        const auto index = static_cast<size_t>(i);
+        values[index] = static_cast<T>(kernel[index]);
+
+        keys[index] = radix_key(key(index, values[index]));
+        indices[index] = static_cast<glm::uint32>(index);
     }
 
-    bool operator()(const T & a, const T & b) const
+    radix_sort(keys, indices);
+
+    #pragma omp parallel for
+    for (long long i = 0; i < static_cast<long long>(size); ++i)
+        kernel[static_cast<size_t>(i)] = values[indices[static_cast<size_t>(i)]];
+
+    return indices;
+}
+
+// cell of the value within 2^bits cells per axis, given the lower bound and the number of cells per unit
+template <typename V>
+glm::u32vec3 curve_cell(const V & value, const V & lower, const V & scale, const glm::uint32 bits)
+{
+    using value_type = typename V::value_type;
+
+    const auto last = static_cast<value_type>((1u << bits) - 1u);
+
+    auto cell = glm::u32vec3{ 0u, 0u, 0u };
+    for (glm::length_t c = 0; c < V::length(); ++c)
     {
-        return glm::distance(a, m_origin) < glm::distance(b, m_origin);
+        const auto t = (value[c] - lower[c]) * scale[c];
+        cell[c] = t > 0 ? static_cast<glm::uint32>(std::min(t, last)) : 0u;
     }
+    return cell;
+}
 
-private:
-    T m_origin;
+template <typename V>
+V curve_scale(const V & lower, const V & upper, const glm::uint32 bits)
+{
+    using value_type = typename V::value_type;
+
+    auto scale = V(0);
+    for (glm::length_t c = 0; c < V::length(); ++c)
+        scale[c] = upper[c] > lower[c] ? static_cast<value_type>(1u << bits) / (upper[c] - lower[c]) : value_type(0);
+    return scale;
+}
+
+// bits per axis of 2D and 3D cells, such that keys fit into 32 and 64 bit
+template <glm::length_t L>
+struct curve_bits
+{
+    static const glm::uint32 value = L == 2 ? 16u : 21u;
 };
 
-template <typename T>
-void distance(tkernel<T> & kernel, const T & origin)
+// interleaved bits of the coordinates, the first coordinate being the least significant
+template <glm::length_t L, typename Key>
+Key morton_code(const glm::u32vec3 & cell)
+{
+    auto key = Key{ 0 };
+    for (auto b = curve_bits<L>::value; b-- > 0u; )
+        for (glm::length_t c = L; c-- > 0; )
+            key = (key << 1u) | static_cast<Key>((cell[c] >> b) & 1u);
+    return key;
+}
+
+// Hilbert index by Skilling's transpose ("Programming the Hilbert curve", 2004)
+template <glm::length_t L, typename Key>
+Key hilbert_code(glm::u32vec3 cell)
+{
+    const auto bits = curve_bits<L>::value;
+    const auto m = 1u << (bits - 1u);
+
+    // inverse undo excess work
+    for (auto q = m; q > 1u; q >>= 1u)
+    {
+        const auto p = q - 1u;
+        for (glm::length_t c = 0; c < L; ++c)
+        {
+            if (cell[c] & q)
+            {
+                cell[0] ^= p;
+                continue;
+            }
+            const auto t = (cell[0] ^ cell[c]) & p;
+            cell[0] ^= t;
+            cell[c] ^= t;
+        }
+    }
+
+    // gray encode
+    for (glm::length_t c = 1; c < L; ++c)
+        cell[c] ^= cell[c - 1];
+
+    auto t = 0u;
+    for (auto q = m; q > 1u; q >>= 1u)
+        if (cell[L - 1] & q)
+            t ^= q - 1u;
+
+    for (glm::length_t c = 0; c < L; ++c)
+        cell[c] ^= t;
+
+    // the transposed index, the first coordinate holding the most significant bits
+    auto key = Key{ 0 };
+    for (auto b = bits; b-- > 0u; )
+        for (glm::length_t c = 0; c < L; ++c)
+            key = (key << 1u) | static_cast<Key>((cell[c] >> b) & 1u);
+    return key;
+}
+
+} // anonymous namespace
+
+
+template <typename T, typename Layout>
+void distance(tkernel<T, Layout> & kernel, const T & origin)
+{
+    // squared distances share the order of the distances
+    sort_by(kernel, [&origin](const size_t, const T & value)
+    {
+        const auto delta = value - origin;
+        return glm::dot(delta, delta);
+    });
+}
+
+template <typename T, typename Layout, typename KeyExtractor>
+std::vector<glm::uint32> by_key(tkernel<T, Layout> & kernel, const KeyExtractor & extractor)
+{
+    return sort_by(kernel, [&extractor](const size_t, const T & value)
+    {
+        return extractor(value);
+    });
+}
+
+template <typename T, typename Layout, typename K, typename KeyLayout>
+std::vector<glm::uint32> by_key(tkernel<T, Layout> & kernel, const tkernel<K, KeyLayout> & keys)
+{
+    assert(keys.size() == kernel.size());
+
+    return sort_by(kernel, [&keys](const size_t index, const T &)
+    {
+        return static_cast<K>(keys[index]);
+    });
+}
+
+template <typename T, typename Layout>
+void reorder(tkernel<T, Layout> & kernel, const std::vector<glm::uint32> & permutation)
+{
+    assert(permutation.size() == kernel.size());
+
+    const auto size = static_cast<long long>(kernel.size());
+    auto values = std::vector<T>(kernel.size());
+
+    #pragma omp parallel for
+    for (long long i = 0; i < size; ++i)
+        values[static_cast<size_t>(i)] = static_cast<T>(kernel[static_cast<size_t>(i)]);
+
+    #pragma omp parallel for
+    for (long long i = 0; i < size; ++i)
+        kernel[static_cast<size_t>(i)] = values[permutation[static_cast<size_t>(i)]];
+}
+
+
+template <typename V>
+morton<V>::morton(const V & lower, const V & upper)
+: m_lower{ lower }
+, m_scale{ curve_scale(lower, upper, curve_bits<V::length()>::value) }
+{
+    static_assert(V::length() == 2 || V::length() == 3, "morton keys are supported for 2D and 3D values");
+}
+
+template <typename V>
+typename morton<V>::key_type morton<V>::operator()(const V & value) const
+{
+    return morton_code<V::length(), key_type>(curve_cell(value, m_lower, m_scale, curve_bits<V::length()>::value));
+}
+
+template <typename V>
+hilbert<V>::hilbert(const V & lower, const V & upper)
+: m_lower{ lower }
+, m_scale{ curve_scale(lower, upper, curve_bits<V::length()>::value) }
+{
+    static_assert(V::length() == 2 || V::length() == 3, "hilbert keys are supported for 2D and 3D values");
+}
+
+template <typename V>
+typename hilbert<V>::key_type hilbert<V>::operator()(const V & value) const
+{
+    return hilbert_code<V::length(), key_type>(curve_cell(value, m_lower, m_scale, curve_bits<V::length()>::value));
+}
+
+template <typename V>
+angle<V>::angle(const V & origin)
+: m_origin{ origin }
+{
+}
+
+template <typename V>
+typename V::value_type angle<V>::operator()(const V & value) const
+{
+    return std::atan2(value[1] - m_origin[1], value[0] - m_origin[0]);
+}
+
+template <typename V>
+projection<V>::projection(const V & axis)
+: m_axis{ axis }
+{
+}
+
+template <typename V>
+typename kernel_component<V>::type projection<V>::operator()(const V & value) const
 {
-    const distance_comparator<T> comparator {origin};
-    std::sort(kernel.begin(), kernel.end(), comparator);
+    return glm::dot(value, m_axis);
 }
 
 
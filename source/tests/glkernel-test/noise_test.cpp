@@ -2,6 +2,15 @@
 #include <gmock/gmock.h>
 
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
@@ -102,3 +111,543 @@ TEST_F(noise_test, perlin_tileability)
         }
     }
 }
+
+TEST_F(noise_test, uniform_seeded)
+{
+    auto fkernel4 = glkernel::kernel4{ 64, 64 };
+    auto reference = glkernel::kernel4{ 64, 64 };
+
+    glkernel::noise::uniform(fkernel4, 0.f, 1.f, 42u);
+    glkernel::noise::uniform(reference, 0.f, 1.f, 42u);
+
+    for (size_t i = 0; i < fkernel4.size(); ++i)
+    {
+        EXPECT_EQ(reference[i], fkernel4[i]);
+
+        for (glm::length_t c = 0; c < 4; ++c)
+        {
+            EXPECT_LE(0.f, fkernel4[i][c]);
+            EXPECT_GT(1.f, fkernel4[i][c]);
+        }
+    }
+}
+
+TEST_F(noise_test, normal_seeded)
+{
+    auto dkernel1 = glkernel::dkernel1{ 256, 256 };
+    auto reference = glkernel::dkernel1{ 256, 256 };
+
+    glkernel::noise::normal(dkernel1, 1.0, 2.0, 42u);
+    glkernel::noise::normal(reference, 1.0, 2.0, 42u);
+
+    auto mean = 0.0;
+    for (size_t i = 0; i < dkernel1.size(); ++i)
+    {
+        EXPECT_EQ(reference[i], dkernel1[i]);
+        mean += dkernel1[i];
+    }
+    mean /= dkernel1.size();
+
+    auto variance = 0.0;
+    for (size_t i = 0; i < dkernel1.size(); ++i)
+        variance += (dkernel1[i] - mean) * (dkernel1[i] - mean);
+    variance /= dkernel1.size();
+
+    EXPECT_NEAR(1.0, mean, 0.05);
+    EXPECT_NEAR(4.0, variance, 0.1);
+}
+
+TEST_F(noise_test, uniform_soa_matches_aos)
+{
+    auto aos = glkernel::kernel4{ 33, 17 };
+    auto soa = glkernel::tkernel<glm::vec4, glkernel::layout::soa>{ 33, 17 };
+
+    glkernel::noise::uniform(aos, glm::vec4{ 0.f }, glm::vec4{ 1.f, 2.f, 3.f, 4.f }, 42u);
+    glkernel::noise::uniform(soa, glm::vec4{ 0.f }, glm::vec4{ 1.f, 2.f, 3.f, 4.f }, 42u);
+
+    for (size_t i = 0; i < aos.size(); ++i)
+        EXPECT_EQ(aos[i], static_cast<glm::vec4>(soa[i]));
+}
+
+TEST_F(noise_test, uniform_view_matches_aos)
+{
+    auto aos = glkernel::kernel2{ 7, 5 };
+    glkernel::noise::uniform(aos, 0.f, 1.f, 42u);
+
+    // generate in place into pitched external memory (e.g., a mapped texture with 64 byte row alignment)
+    auto memory = std::vector<glm::vec2>(8 * 5, glm::vec2{ -1.f });
+    auto view = glkernel::kernel2_view{ memory.data(), 7, 5, 1, 8 * sizeof(glm::vec2) };
+    glkernel::noise::uniform(view, 0.f, 1.f, 42u);
+
+    for (size_t i = 0; i < aos.size(); ++i)
+        EXPECT_EQ(aos[i], view[i]);
+
+    EXPECT_EQ(glm::vec2{ -1.f }, memory[7]);
+}
+
+TEST_F(noise_test, gradient_reference_values)
+{
+    // values of the former per-voxel implementation
+    auto perlin = glkernel::dkernel1{ 37, 19, 11 };
+    glkernel::noise::gradient(perlin, glkernel::noise::GradientNoiseType::Perlin, glkernel::noise::OctaveType::Cloud, 2, 6);
+
+    EXPECT_DOUBLE_EQ(0.5, perlin[0]);
+    EXPECT_DOUBLE_EQ(0.34737621491872317, perlin[1234]);
+    EXPECT_DOUBLE_EQ(0.47122748919611968, perlin[5000]);
+    EXPECT_DOUBLE_EQ(0.82875578615569867, perlin[7732]);
+
+    glkernel::noise::gradient(perlin, glkernel::noise::GradientNoiseType::Perlin, glkernel::noise::OctaveType::Paper, 2, 6);
+
+    EXPECT_DOUBLE_EQ(0.4638730655316784, perlin[1234]);
+    EXPECT_DOUBLE_EQ(0.41636254902671233, perlin[5000]);
+    EXPECT_DOUBLE_EQ(0.59894192325532547, perlin[7732]);
+
+    auto simplex = glkernel::dkernel1{ 37, 19, 11 };
+    glkernel::noise::gradient(simplex, glkernel::noise::GradientNoiseType::Simplex, glkernel::noise::OctaveType::Cloud, 2, 6);
+
+    EXPECT_NEAR(0.28121555237168983, simplex[1234], 1e-14);
+    EXPECT_NEAR(0.95944061985122719, simplex[5000], 1e-14);
+    EXPECT_NEAR(0.79064769971868631, simplex[7732], 1e-14);
+}
+
+TEST_F(noise_test, gradient_layouts_match)
+{
+    auto aos = glkernel::kernel1{ 24, 16, 4 };
+    auto soa = glkernel::tkernel<float, glkernel::layout::soa>{ 24, 16, 4 };
+
+    glkernel::noise::gradient(aos, glkernel::noise::GradientNoiseType::Simplex, glkernel::noise::OctaveType::Wood);
+    glkernel::noise::gradient(soa, glkernel::noise::GradientNoiseType::Simplex, glkernel::noise::OctaveType::Wood);
+
+    for (size_t i = 0; i < aos.size(); ++i)
+        EXPECT_EQ(aos[i], static_cast<float>(soa[i]));
+}
+
+TEST_F(noise_test, gradient_planar)
+{
+    // 2D perlin noise of flat kernels equals the first slice of 3D noise
+    auto planar = glkernel::dkernel1{ 48, 32 };
+    auto volume = glkernel::dkernel1{ 48, 32, 4 };
+
+    glkernel::noise::gradient(planar, glkernel::noise::GradientNoiseType::Perlin, glkernel::noise::OctaveType::Cloud);
+    glkernel::noise::gradient(volume, glkernel::noise::GradientNoiseType::Perlin, glkernel::noise::OctaveType::Cloud);
+
+    for (glm::uint32 t = 0; t < planar.height(); ++t)
+        for (glm::uint32 s = 0; s < planar.width(); ++s)
+            EXPECT_EQ(volume.value(s, t, 0), planar.value(s, t));
+
+    // 2D simplex noise of a single octave stays within [-1, 1] (offset by 0.5)
+    glkernel::noise::gradient(planar, glkernel::noise::GradientNoiseType::Simplex, glkernel::noise::OctaveType::Standard, 3, 1);
+
+    auto min_value = planar[0];
+    auto max_value = planar[0];
+    for (size_t i = 0; i < planar.size(); ++i)
+    {
+        min_value = std::min(min_value, planar[i]);
+        max_value = std::max(max_value, planar[i]);
+    }
+    EXPECT_LE(-0.5, min_value);
+    EXPECT_GE(1.5, max_value);
+    EXPECT_LT(max_value - min_value, 2.0);
+    EXPECT_GT(max_value - min_value, 0.5);
+}
+
+TEST_F(noise_test, gradient_bricks_match_kernel)
+{
+    const auto extent = glm::u32vec3{ 20, 12, 10 };
+
+    auto reference = glkernel::dkernel1{ extent };
+    glkernel::noise::gradient(reference, glkernel::noise::GradientNoiseType::Perlin, glkernel::noise::OctaveType::CloudAbs, 2, 4);
+
+    // assemble the bricks, including cropped ones at the border
+    auto assembled = glkernel::dkernel1{ extent };
+    auto num_bricks = 0;
+    glkernel::noise::gradient<double>(extent, glm::u32vec3{ 8 }, [&](const glkernel::dkernel1 & brick, const glm::u32vec3 & offset)
+    {
+        ++num_bricks;
+        for (glm::uint32 r = 0; r < brick.depth(); ++r)
+            for (glm::uint32 t = 0; t < brick.height(); ++t)
+                for (glm::uint32 s = 0; s < brick.width(); ++s)
+                    assembled.value(offset.x + s, offset.y + t, offset.z + r) = brick.value(s, t, r);
+    }, glkernel::noise::GradientNoiseType::Perlin, glkernel::noise::OctaveType::CloudAbs, 2, 4);
+
+    EXPECT_EQ(3 * 2 * 2, num_bricks);
+    for (size_t i = 0; i < reference.size(); ++i)
+        EXPECT_EQ(reference[i], assembled[i]);
+
+    // stream the volume as raw data (string streams cannot seek beyond their end)
+    auto stream = std::ostringstream{ std::string(reference.size() * sizeof(double), '\0'), std::ios::binary };
+    auto writer = glkernel::noise::volume_writer<double>{ stream, extent };
+    glkernel::noise::gradient<double>(extent, glm::u32vec3{ 16, 16, 4 }, writer
+        , glkernel::noise::GradientNoiseType::Perlin, glkernel::noise::OctaveType::CloudAbs, 2, 4);
+
+    const auto data = stream.str();
+    ASSERT_EQ(reference.size() * sizeof(double), data.size());
+    EXPECT_EQ(0, std::memcmp(data.data(), reference.data(), data.size()));
+}
+
+TEST_F(noise_test, cellular_features)
+{
+    auto f1 = glkernel::dkernel1{ 32, 24, 8 };
+    auto f2 = glkernel::dkernel1{ 32, 24, 8 };
+    auto difference = glkernel::dkernel1{ 32, 24, 8 };
+    auto pairs = glkernel::dkernel2{ 32, 24, 8 };
+
+    glkernel::noise::cellular(f1, glkernel::noise::CellularNoiseType::F1, glkernel::noise::OctaveType::Standard, 2, 1, 42);
+    glkernel::noise::cellular(f2, glkernel::noise::CellularNoiseType::F2, glkernel::noise::OctaveType::Standard, 2, 1, 42);
+    glkernel::noise::cellular(difference, glkernel::noise::CellularNoiseType::F2MinusF1, glkernel::noise::OctaveType::Standard, 2, 1, 42);
+    glkernel::noise::cellular(pairs, glkernel::noise::OctaveType::Standard, 2, 1, 42);
+
+    for (size_t i = 0; i < f1.size(); ++i)
+    {
+        // the nearest feature lies within the sample's cell or a neighbor
+        EXPECT_LE(0.0, f1[i]);
+        EXPECT_GE(std::sqrt(3.0), f1[i]);
+        EXPECT_LE(f1[i], f2[i]);
+        EXPECT_DOUBLE_EQ(f2[i] - f1[i], difference[i]);
+        EXPECT_EQ(f1[i], pairs[i].x);
+        EXPECT_EQ(f2[i], pairs[i].y);
+    }
+
+    // distinct seeds yield distinct feature points
+    auto other = glkernel::dkernel1{ 32, 24, 8 };
+    glkernel::noise::cellular(other, glkernel::noise::CellularNoiseType::F1, glkernel::noise::OctaveType::Standard, 2, 1, 43);
+    auto num_equal = 0;
+    for (size_t i = 0; i < f1.size(); ++i)
+        num_equal += f1[i] == other[i];
+    EXPECT_GT(f1.size() / 2, static_cast<size_t>(num_equal));
+}
+
+TEST_F(noise_test, cellular_tileability)
+{
+    // F1 changes by at most the step between samples (in cells), also across the borders
+    auto kernel = glkernel::dkernel1{ 32, 32 };
+    glkernel::noise::cellular(kernel, glkernel::noise::CellularNoiseType::F1, glkernel::noise::OctaveType::Standard, 3, 1, 7);
+
+    const auto step = 8.0 / 32.0 + 1e-12;
+    for (glm::uint32 t = 0; t < kernel.height(); ++t)
+    {
+        for (glm::uint32 s = 0; s < kernel.width(); ++s)
+        {
+            EXPECT_GE(step, std::abs(kernel.value(s, t) - kernel.value((s + 1) % 32, t)));
+            EXPECT_GE(step, std::abs(kernel.value(s, t) - kernel.value(s, (t + 1) % 32)));
+        }
+    }
+}
+
+TEST_F(noise_test, cellular_brute_force)
+{
+    // compare 3D F1 and F2 with a search over all (wrapped) feature points of a 4x4x4 grid
+    auto kernel = glkernel::dkernel2{ 12, 10, 9 };
+    glkernel::noise::cellular(kernel, glkernel::noise::OctaveType::Standard, 2, 1, 5);
+
+    const auto frequency = 4;
+    const auto key = glkernel::random::philox_engine{ 5, 0, 0 }();
+
+    auto num_outside = 0;
+    for (glm::uint32 z = 0; z < kernel.depth(); ++z)
+    {
+        for (glm::uint32 y = 0; y < kernel.height(); ++y)
+        {
+            for (glm::uint32 x = 0; x < kernel.width(); ++x)
+            {
+                const auto p = glm::dvec3(static_cast<double>(x) / kernel.width()
+                    , static_cast<double>(y) / kernel.height(), static_cast<double>(z) / kernel.depth()) * static_cast<double>(frequency);
+                const auto cell = glm::floor(p);
+
+                // all feature points, and only those of the 3x3x3 cells around the sample
+                auto d1 = std::numeric_limits<double>::max();
+                auto d2 = std::numeric_limits<double>::max();
+                auto n1 = std::numeric_limits<double>::max();
+                auto n2 = std::numeric_limits<double>::max();
+
+                for (auto cs = -frequency; cs < 2 * frequency; ++cs)
+                {
+                    for (auto ct = -frequency; ct < 2 * frequency; ++ct)
+                    {
+                        for (auto cu = -frequency; cu < 2 * frequency; ++cu)
+                        {
+                            const auto mask = frequency - 1;
+                            auto h = hash_cell(cs & mask, ct & mask, cu & mask, key);
+
+                            auto feature = glm::dvec3(cs, ct, cu);
+                            feature.x += unit_hash<double>(h);
+                            h = mix32(h);
+                            feature.y += unit_hash<double>(h);
+                            h = mix32(h);
+                            feature.z += unit_hash<double>(h);
+
+                            const auto delta = feature - p;
+                            const auto d = glm::dot(delta, delta);
+
+                            d2 = std::min(d2, std::max(d1, d));
+                            d1 = std::min(d1, d);
+
+                            if (std::abs(cs - cell.x) > 1.0 || std::abs(ct - cell.y) > 1.0 || std::abs(cu - cell.z) > 1.0)
+                                continue;
+
+                            n2 = std::min(n2, std::max(n1, d));
+                            n1 = std::min(n1, d);
+                        }
+                    }
+                }
+
+                const auto & f = kernel.value(x, y, z);
+                EXPECT_NEAR(std::sqrt(n1), f.x, 1e-12);
+                EXPECT_NEAR(std::sqrt(n2), f.y, 1e-12);
+
+                // a feature point outside the neighborhood is rarely nearer than those within
+                EXPECT_LE(std::sqrt(d1), f.x + 1e-12);
+                EXPECT_LE(std::sqrt(d2), f.y + 1e-12);
+                num_outside += f.x > std::sqrt(d1) + 1e-12 || f.y > std::sqrt(d2) + 1e-12;
+            }
+        }
+    }
+    EXPECT_GT(static_cast<int>(kernel.size() / 50), num_outside);
+}
+
+TEST_F(noise_test, cellular_layouts_match)
+{
+    auto kernel = glkernel::dkernel2{ 20, 12, 6 };
+    glkernel::noise::cellular(kernel, glkernel::noise::OctaveType::Standard, 2, 1, 3);
+
+    auto soa = glkernel::tkernel<glm::dvec2, glkernel::layout::soa>{ 20, 12, 6 };
+    glkernel::noise::cellular(soa, glkernel::noise::OctaveType::Standard, 2, 1, 3);
+
+    for (size_t i = 0; i < kernel.size(); ++i)
+        EXPECT_EQ(kernel[i], static_cast<glm::dvec2>(soa[i]));
+
+    // multiple octaves are combined like gradient noise
+    auto octaves = glkernel::dkernel1{ 20, 12, 6 };
+    glkernel::noise::cellular(octaves, glkernel::noise::CellularNoiseType::F1, glkernel::noise::OctaveType::Cloud, 2, 3, 3);
+    for (size_t i = 0; i < octaves.size(); ++i)
+        EXPECT_LE(0.0, octaves[i]);
+}
+
+TEST_F(noise_test, spectral_statistics)
+{
+    auto kernel = glkernel::dkernel1{ 32, 16, 4 };
+    glkernel::noise::spectral(kernel, glkernel::noise::SpectralNoiseType::White, 11);
+
+    auto sum = 0.0;
+    auto sum_squares = 0.0;
+    for (size_t i = 0; i < kernel.size(); ++i)
+    {
+        sum += kernel[i];
+        sum_squares += kernel[i] * kernel[i];
+    }
+
+    EXPECT_NEAR(0.0, sum / kernel.size(), 1e-12);
+    EXPECT_NEAR(1.0, sum_squares / kernel.size(), 1e-12);
+
+    // both fields of a kernel2 share the transform, x equals the scalar noise
+    auto pairs = glkernel::dkernel2{ 32, 16, 4 };
+    glkernel::noise::spectral(pairs, glkernel::noise::SpectralNoiseType::White, 11);
+
+    for (size_t i = 0; i < kernel.size(); ++i)
+        EXPECT_EQ(kernel[i], pairs[i].x);
+}
+
+TEST_F(noise_test, spectral_colors)
+{
+    // neighboring values of red noise correlate, those of blue noise anticorrelate
+    const auto correlation = [](const glkernel::dkernel1 & kernel)
+    {
+        auto sum = 0.0;
+        for (glm::uint32 t = 0; t < kernel.height(); ++t)
+            for (glm::uint32 s = 0; s < kernel.width(); ++s)
+                sum += kernel.value(s, t) * kernel.value((s + 1) % kernel.width(), t);
+        return sum / kernel.size();
+    };
+
+    auto kernel = glkernel::dkernel1{ 64, 64 };
+
+    glkernel::noise::spectral(kernel, glkernel::noise::SpectralNoiseType::Pink, 5);
+    const auto pink = correlation(kernel);
+    glkernel::noise::spectral(kernel, glkernel::noise::SpectralNoiseType::Brown, 5);
+    const auto brown = correlation(kernel);
+    glkernel::noise::spectral(kernel, glkernel::noise::SpectralNoiseType::Blue, 5);
+    const auto blue = correlation(kernel);
+
+    EXPECT_LT(0.1, pink);
+    EXPECT_LT(pink, brown);
+    EXPECT_GT(0.0, blue);
+}
+
+TEST_F(noise_test, spectral_custom_spectrum)
+{
+    // a single (radial) frequency of one cycle per kernel changes its sign after half a period,
+    // using mixed-radix transforms of lengths 30 and 20
+    auto kernel = glkernel::dkernel1{ 30, 20 };
+    glkernel::noise::spectral(kernel, [](const double frequency)
+    {
+        return frequency < 1.2 ? 1.0 : 0.0;
+    }, 3);
+
+    for (glm::uint32 t = 0; t < kernel.height(); ++t)
+        for (glm::uint32 s = 0; s < kernel.width(); ++s)
+            EXPECT_NEAR(-kernel.value(s, t), kernel.value((s + 15) % 30, (t + 10) % 20), 1e-12);
+}
+
+TEST_F(noise_test, gradient_vector_components)
+{
+    // the first component equals scalar noise, the others use their own gradients
+    auto scalar = glkernel::dkernel1{ 23, 17, 5 };
+    auto vector = glkernel::dkernel3{ 23, 17, 5 };
+
+    glkernel::noise::gradient(scalar, glkernel::noise::GradientNoiseType::Perlin, glkernel::noise::OctaveType::Cloud);
+    glkernel::noise::gradient(vector, glkernel::noise::GradientNoiseType::Perlin, glkernel::noise::OctaveType::Cloud);
+
+    auto num_equal = 0;
+    for (size_t i = 0; i < scalar.size(); ++i)
+    {
+        EXPECT_EQ(scalar[i], vector[i].x);
+        num_equal += vector[i].x == vector[i].y || vector[i].y == vector[i].z;
+    }
+    EXPECT_GT(static_cast<int>(scalar.size() / 10), num_equal);
+
+    auto planar = glkernel::dkernel1{ 24, 16 };
+    auto planar_vector = glkernel::tkernel<glm::dvec4, glkernel::layout::soa>{ 24, 16 };
+
+    glkernel::noise::gradient(planar, glkernel::noise::GradientNoiseType::Perlin, glkernel::noise::OctaveType::Wood, 2, 3);
+    glkernel::noise::gradient(planar_vector, glkernel::noise::GradientNoiseType::Perlin, glkernel::noise::OctaveType::Wood, 2, 3);
+
+    for (size_t i = 0; i < planar.size(); ++i)
+        EXPECT_EQ(planar[i], static_cast<glm::dvec4>(planar_vector[i]).x);
+}
+
+TEST_F(noise_test, gradient_vector_simplex_components)
+{
+    // 8 samples per cell at frequency 8: components must not be translates of each other by whole cells
+    for (const auto depth : { 1u, 4u })
+    {
+        auto scalar = glkernel::dkernel1{ 64, 16, depth };
+        auto vector = glkernel::dkernel3{ 64, 16, depth };
+
+        glkernel::noise::gradient(scalar, glkernel::noise::GradientNoiseType::Simplex, glkernel::noise::OctaveType::Standard, 3, 1);
+        glkernel::noise::gradient(vector, glkernel::noise::GradientNoiseType::Simplex, glkernel::noise::OctaveType::Standard, 3, 1);
+
+        auto num_translated = 0;
+        auto num_equal = 0;
+        for (glm::uint32 u = 0; u < depth; ++u)
+        {
+            for (glm::uint32 t = 0; t < 16; ++t)
+            {
+                for (glm::uint32 s = 0; s < 64; ++s)
+                {
+                    const auto & value = vector.value(s, t, u);
+                    EXPECT_EQ(scalar.value(s, t, u), value.x);
+
+                    // all components vanish on lattice points
+                    if (value.x == 0.5 && value.y == 0.5 && value.z == 0.5)
+                        continue;
+
+                    for (glm::uint32 c = 1; c < 3; ++c)
+                        num_translated += value[c] == vector.value((s + c * 8) % 64, t, u).x;
+                    num_equal += value.x == value.y || value.y == value.z;
+                }
+            }
+        }
+        EXPECT_GT(static_cast<int>(scalar.size() / 10), num_translated);
+        EXPECT_GT(static_cast<int>(scalar.size() / 10), num_equal);
+    }
+}
+
+TEST_F(noise_test, curl_planar)
+{
+    // compare with central differences of the potential, measured per cell (64 samples)
+    auto potential = glkernel::dkernel1{ 128, 128 };
+    auto curl = glkernel::dkernel2{ 128, 128 };
+
+    glkernel::noise::gradient(potential, glkernel::noise::GradientNoiseType::Perlin, glkernel::noise::OctaveType::Standard, 1, 1);
+    glkernel::noise::curl(curl, 1, 1);
+
+    for (glm::uint32 t = 0; t < curl.height(); ++t)
+    {
+        for (glm::uint32 s = 0; s < curl.width(); ++s)
+        {
+            const auto ds = (potential.value((s + 1) % 128, t) - potential.value((s + 127) % 128, t)) * 32.0;
+            const auto dt = (potential.value(s, (t + 1) % 128) - potential.value(s, (t + 127) % 128)) * 32.0;
+
+            EXPECT_NEAR(dt, curl.value(s, t).x, 2e-2);
+            EXPECT_NEAR(-ds, curl.value(s, t).y, 2e-2);
+        }
+    }
+}
+
+TEST_F(noise_test, curl_divergence_free)
+{
+    const auto n = 32u;
+    auto curl = glkernel::dkernel3{ n, n, n };
+    glkernel::noise::curl(curl, 1, 1);
+
+    // central differences per cell (16 samples)
+    for (glm::uint32 r = 0; r < n; ++r)
+    {
+        for (glm::uint32 t = 0; t < n; ++t)
+        {
+            for (glm::uint32 s = 0; s < n; ++s)
+            {
+                const auto divergence = 8.0 * (
+                    curl.value((s + 1) % n, t, r).x - curl.value((s + n - 1) % n, t, r).x +
+                    curl.value(s, (t + 1) % n, r).y - curl.value(s, (t + n - 1) % n, r).y +
+                    curl.value(s, t, (r + 1) % n).z - curl.value(s, t, (r + n - 1) % n).z);
+
+                EXPECT_NEAR(0.0, divergence, 0.25);
+            }
+        }
+    }
+}
+
+TEST_F(noise_test, gradient_context)
+{
+    auto standard = glkernel::dkernel1{ 23, 17, 5 };
+    auto explicit_standard = glkernel::dkernel1{ 23, 17, 5 };
+    auto seeded = glkernel::dkernel1{ 23, 17, 5 };
+    auto cached = glkernel::dkernel1{ 23, 17, 5 };
+    auto other = glkernel::dkernel1{ 23, 17, 5 };
+
+    const auto context = glkernel::noise::gradient_context{ 1 };
+
+    glkernel::noise::gradient(standard, glkernel::noise::GradientNoiseType::Perlin, glkernel::noise::OctaveType::Cloud);
+    glkernel::noise::gradient(explicit_standard, glkernel::noise::GradientNoiseType::Perlin, glkernel::noise::OctaveType::Cloud, 3, 5
+        , glkernel::noise::gradient_context::standard());
+    glkernel::noise::gradient(seeded, glkernel::noise::GradientNoiseType::Perlin, glkernel::noise::OctaveType::Cloud, 3, 5, context);
+    glkernel::noise::gradient(cached, glkernel::noise::GradientNoiseType::Perlin, glkernel::noise::OctaveType::Cloud, 3, 5
+        , glkernel::noise::gradient_context::cached(1));
+    glkernel::noise::gradient(other, glkernel::noise::GradientNoiseType::Perlin, glkernel::noise::OctaveType::Cloud, 3, 5
+        , glkernel::noise::gradient_context::cached(2));
+
+    EXPECT_EQ(&glkernel::noise::gradient_context::cached(1), &glkernel::noise::gradient_context::cached(1));
+    EXPECT_NE(&glkernel::noise::gradient_context::cached(1), &glkernel::noise::gradient_context::cached(1, 9));
+
+    auto num_standard_equal = 0;
+    auto num_other_equal = 0;
+    for (size_t i = 0; i < standard.size(); ++i)
+    {
+        EXPECT_EQ(standard[i], explicit_standard[i]);
+        EXPECT_EQ(seeded[i], cached[i]);
+        num_standard_equal += standard[i] == seeded[i];
+        num_other_equal += other[i] == seeded[i];
+    }
+    EXPECT_GT(static_cast<int>(standard.size() / 10), num_standard_equal);
+    EXPECT_GT(static_cast<int>(standard.size() / 10), num_other_equal);
+}
+
+TEST_F(noise_test, gradient_context_high_frequency)
+{
+    // frequencies beyond 1 << 8 require larger tables
+    const auto & context = glkernel::noise::gradient_context::cached(3, 12);
+    EXPECT_EQ(12u, context.bits());
+
+    auto kernel = glkernel::dkernel1{ 4096, 2 };
+    glkernel::noise::gradient(kernel, glkernel::noise::GradientNoiseType::Perlin, glkernel::noise::OctaveType::Standard, 11, 1, context);
+
+    // values at lattice points vanish (offset by 0.5), those in between do not
+    auto num_lattice = 0;
+    for (glm::uint32 s = 0; s < kernel.width(); s += 2)
+    {
+        EXPECT_EQ(0.5, kernel.value(s, 0));
+        num_lattice += kernel.value(s + 1, 0) == 0.5;
+    }
+    EXPECT_GT(static_cast<int>(kernel.width() / 4), num_lattice);
+}
@@ -0,0 +1,132 @@
+#include <gmock/gmock.h>
+
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include <glkernel/random.h>
+
+
+class random_test: public testing::Test
+{
+public:
+};
+
+TEST_F(random_test, philox_known_answers)
+{
+    // known answer tests of the Random123 reference implementation
+    const auto zero = glkernel::random::philox4x32(
+        glm::u32vec4{ 0u, 0u, 0u, 0u }, glm::u32vec2{ 0u, 0u });
+
+    EXPECT_EQ(0x6627e8d5u, zero[0]);
+    EXPECT_EQ(0xe169c58du, zero[1]);
+    EXPECT_EQ(0xbc57ac4cu, zero[2]);
+    EXPECT_EQ(0x9b00dbd8u, zero[3]);
+
+    const auto pi = glkernel::random::philox4x32(
+        glm::u32vec4{ 0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u }, glm::u32vec2{ 0xa4093822u, 0x299f31d0u });
+
+    EXPECT_EQ(0xd16cfe09u, pi[0]);
+    EXPECT_EQ(0x94fdccebu, pi[1]);
+    EXPECT_EQ(0x5001e420u, pi[2]);
+    EXPECT_EQ(0x24126ea1u, pi[3]);
+}
+
+TEST_F(random_test, engine_reproducible)
+{
+    auto a = glkernel::random::philox_engine{ 42u, 7u, 1u };
+    auto b = glkernel::random::philox_engine{ 42u, 7u, 1u };
+    auto c = glkernel::random::philox_engine{ 42u, 7u, 2u };
+
+    auto differs = false;
+    for (int i = 0; i < 16; ++i)
+    {
+        const auto value = a();
+        EXPECT_EQ(value, b());
+        differs |= value != c();
+    }
+    EXPECT_TRUE(differs);
+}
+
+TEST_F(random_test, uniform_range)
+{
+    auto generator = glkernel::random::philox_engine{ 42u };
+
+    for (int i = 0; i < 1024; ++i)
+    {
+        const auto f = glkernel::random::uniform(generator, -1.f, 1.f);
+        EXPECT_LE(-1.f, f);
+        EXPECT_GT( 1.f, f);
+
+        const auto d = glkernel::random::uniform<double>(generator);
+        EXPECT_LE(0.0, d);
+        EXPECT_GT(1.0, d);
+
+        EXPECT_GT(7u, glkernel::random::bounded(generator, 7u));
+    }
+}
+
+TEST_F(random_test, shuffle_is_permutation)
+{
+    auto values = std::vector<int>(100);
+    std::iota(values.begin(), values.end(), 0);
+
+    auto generator = glkernel::random::philox_engine{ 42u };
+    glkernel::random::shuffle(values.begin(), values.end(), generator);
+
+    auto sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(i, sorted[i]);
+}
+
+TEST_F(random_test, permute_is_permutation)
+{
+    for (glm::uint32 length : { 1u, 2u, 7u, 64u, 1000u })
+    {
+        for (glm::uint32 key : { 0u, 1u, 0xdeadbeefu })
+        {
+            auto hit = std::vector<bool>(length, false);
+            for (glm::uint32 i = 0; i < length; ++i)
+            {
+                const auto j = glkernel::random::permute(i, length, key);
+                ASSERT_LT(j, length);
+                EXPECT_FALSE(hit[j]);
+                hit[j] = true;
+            }
+        }
+    }
+}
+
+TEST_F(random_test, normal_distribution)
+{
+    // compares the empirical distribution function with the normal one, including the tails
+    const auto count = 1000000;
+    const double thresholds[] = { -4.0, -3.0, -2.0, -1.0, -0.5, 0.0, 0.5, 1.0, 2.0, 3.0, 4.0 };
+
+    for (int precision = 0; precision < 2; ++precision)
+    {
+        auto below = std::vector<int>(11, 0);
+        auto generator = glkernel::random::philox_engine{ 42u };
+
+        for (int i = 0; i < count; ++i)
+        {
+            const auto value = precision == 0
+                ? static_cast<double>(glkernel::random::normal(generator, 0.f, 1.f))
+                : glkernel::random::normal(generator, 0.0, 1.0);
+
+            for (size_t t = 0; t < below.size(); ++t)
+                below[t] += value < thresholds[t] ? 1 : 0;
+        }
+
+        for (size_t t = 0; t < below.size(); ++t)
+        {
+            const auto expected = 0.5 * std::erfc(-thresholds[t] / std::sqrt(2.0));
+            const auto tolerance = 5.0 * std::sqrt(expected * (1.0 - expected) / count);
+            EXPECT_NEAR(expected, static_cast<double>(below[t]) / count, tolerance);
+        }
+    }
+}
@@ -0,0 +1,129 @@
+
+#include <gmock/gmock.h>
+
+
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include <glkernel/Kernel.h>
+#include <glkernel/reduce.h>
+#include <glkernel/scale.h>
+
+
+class reduce_test: public testing::Test
+{
+public:
+};
+
+TEST_F(reduce_test, minmax)
+{
+    auto fkernel2 = glkernel::kernel2{ 2, 2 };
+    fkernel2[0] = { -6, 7 };
+    fkernel2[1] = { 5, -9 };
+    fkernel2[2] = { 10, -8 };
+    fkernel2[3] = { -7, -1 };
+
+    const auto minmax = glkernel::reduce::minmax(fkernel2);
+    EXPECT_EQ(glm::vec2(-7, -9), minmax.first);
+    EXPECT_EQ(glm::vec2(10, 7), minmax.second);
+
+    const auto coefficient_minmax = glkernel::reduce::coefficient_minmax(fkernel2);
+    EXPECT_EQ(-9.f, coefficient_minmax.first);
+    EXPECT_EQ(10.f, coefficient_minmax.second);
+
+    // negative values only, over multiple chunks and on a view
+    auto memory = std::vector<double>(100000);
+    for (size_t i = 0; i < memory.size(); ++i)
+        memory[i] = -1.0 - static_cast<double>(i * 7919 % memory.size());
+
+    const auto dview = glkernel::dkernel1_view(memory.data(), 1000, 100);
+    const auto dminmax = glkernel::reduce::minmax(dview);
+    EXPECT_EQ(-100000.0, dminmax.first);
+    EXPECT_EQ(-1.0, dminmax.second);
+}
+
+TEST_F(reduce_test, moments)
+{
+    // 0, 1, ..., n - 1 for the first, and a constant for the second component
+    auto dkernel2 = glkernel::dkernel2{ 300, 301 };
+    for (size_t i = 0; i < dkernel2.size(); ++i)
+        dkernel2[i] = glm::dvec2(static_cast<double>(i), 1e8);
+
+    const auto n = static_cast<double>(dkernel2.size());
+
+    const auto sum = glkernel::reduce::sum(dkernel2);
+    EXPECT_DOUBLE_EQ(n * (n - 1) / 2, sum.x);
+    EXPECT_DOUBLE_EQ(n * 1e8, sum.y);
+
+    const auto mean = glkernel::reduce::mean(dkernel2);
+    EXPECT_DOUBLE_EQ((n - 1) / 2, mean.x);
+    EXPECT_DOUBLE_EQ(1e8, mean.y);
+
+    const auto variance = glkernel::reduce::variance(dkernel2);
+    EXPECT_NEAR((n * n - 1) / 12, variance.x, 1e-6 * n * n);
+    EXPECT_EQ(0.0, variance.y);
+
+    auto soa = glkernel::tkernel<glm::vec4, glkernel::layout::soa>{ 3 };
+    soa[0] = glm::vec4(1.f, 2.f, 3.f, 4.f);
+    soa[1] = glm::vec4(3.f, 2.f, 1.f, 0.f);
+    soa[2] = glm::vec4(2.f, 2.f, 2.f, 2.f);
+    EXPECT_EQ(glm::vec4(2.f), glkernel::reduce::mean(soa));
+    EXPECT_EQ(glm::vec4(2.f, 0.f, 2.f, 8.f) / 3.f, glkernel::reduce::variance(soa));
+}
+
+TEST_F(reduce_test, histogram)
+{
+    auto fkernel2 = glkernel::kernel2{ 100, 100 };
+    for (size_t i = 0; i < fkernel2.size(); ++i)
+        fkernel2[i] = glm::vec2(static_cast<float>(i % 100) / 99.f, static_cast<float>(i % 10) - 2.f);
+
+    const auto bins = glkernel::reduce::histogram(fkernel2, 10, 0.f, 1.f);
+    ASSERT_EQ(10u, bins.size());
+    for (const auto bin : bins)
+        EXPECT_EQ(1000u, bin);
+
+    // values outside of the bounds are not counted
+    const auto y = glkernel::reduce::histogram(fkernel2, 4, 0.f, 4.f, 1);
+    const size_t expected[] = { 1000, 1000, 1000, 2000 };
+    for (size_t i = 0; i < 4; ++i)
+        EXPECT_EQ(expected[i], y[i]);
+}
+
+TEST_F(reduce_test, normalize)
+{
+    auto fkernel4 = glkernel::kernel4{ 2 };
+    fkernel4[0] = glm::vec4(-3.f, 1.f, 5.f, 0.f);
+    fkernel4[1] = glm::vec4(2.f, 3.f, 1.f, -1.f);
+
+    glkernel::scale::normalize(fkernel4, -1.f, 1.f);
+
+    EXPECT_EQ(glm::vec4(-1.f, 0.f, 1.f, -0.25f), fkernel4[0]);
+    EXPECT_EQ(glm::vec4(0.25f, 0.5f, 0.f, -0.5f), fkernel4[1]);
+
+    // a single distinct value is mapped to the lower bound
+    auto fkernel1 = glkernel::kernel1{ 4 };
+    for (size_t i = 0; i < fkernel1.size(); ++i)
+        fkernel1[i] = 3.f;
+
+    glkernel::scale::normalize(fkernel1);
+    for (size_t i = 0; i < fkernel1.size(); ++i)
+        EXPECT_EQ(0.f, fkernel1[i]);
+
+    // also if the value is too large to be incremented (beyond 2^24 for float)
+    for (size_t i = 0; i < fkernel1.size(); ++i)
+        fkernel1[i] = 3e7f;
+
+    glkernel::scale::normalize(fkernel1, 0.5f, 1.f);
+    for (size_t i = 0; i < fkernel1.size(); ++i)
+        EXPECT_EQ(0.5f, fkernel1[i]);
+
+    auto fkernel2 = glkernel::kernel2{ 3 };
+    for (size_t i = 0; i < fkernel2.size(); ++i)
+        fkernel2[i] = glm::vec2(-3e7f);
+
+    glkernel::scale::normalize(fkernel2, -1.f, 1.f);
+    for (size_t i = 0; i < fkernel2.size(); ++i)
+        EXPECT_EQ(glm::vec2(-1.f), fkernel2[i]);
+}
@@ -2,12 +2,19 @@
 #include <gmock/gmock.h>
 
 
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
+#include <glm/gtx/norm.hpp>
+#include <glm/gtc/constants.hpp>
 
 #include <glkernel/Kernel.h>
 #include <glkernel/sample.h>
+#include <glkernel/random.h>
 
 
 class sample_test: public testing::Test
@@ -150,6 +157,47 @@ TEST_F(sample_test, multi_jittered_correlated_same_y_coord_for_column)
     }
 }
 
+TEST_F(sample_test, multi_jittered_n_rooks_non_square)
+{
+    for (bool correlated : { false, true })
+    {
+        auto kernel = glkernel::dkernel2{ 7, 5 };
+
+        glkernel::sample::multi_jittered(kernel, correlated, 42u);
+
+        // every one of the width * height columns and rows contains exactly one sample
+        auto columns = std::vector<int>(kernel.size(), 0);
+        auto rows = std::vector<int>(kernel.size(), 0);
+        for (glm::uint32 y = 0; y < kernel.height(); ++y)
+        {
+            for (glm::uint32 x = 0; x < kernel.width(); ++x)
+            {
+                const auto & sample = kernel.value(x, y);
+                EXPECT_EQ(x, static_cast<glm::uint32>(sample.x * kernel.width()));
+                EXPECT_EQ(y, static_cast<glm::uint32>(sample.y * kernel.height()));
+
+                ++columns[static_cast<size_t>(sample.x * kernel.size())];
+                ++rows[static_cast<size_t>(sample.y * kernel.size())];
+            }
+        }
+        for (size_t i = 0; i < kernel.size(); ++i)
+        {
+            EXPECT_EQ(1, columns[i]);
+            EXPECT_EQ(1, rows[i]);
+        }
+    }
+}
+
+TEST_F(sample_test, multi_jittered_sample_matches_kernel)
+{
+    auto kernel = glkernel::kernel2{ 6, 9 };
+
+    glkernel::sample::multi_jittered(kernel, false, 7u);
+
+    for (glm::uint32 i = 0; i < kernel.size(); ++i)
+        EXPECT_EQ(kernel[i], glkernel::sample::multi_jittered_sample<float>(i, 6, 9, 7u));
+}
+
 TEST_F(sample_test, n_rooks_compile)
 {
     auto fkernel2 = glkernel::kernel2{ 1 };
@@ -371,3 +419,327 @@ TEST_F(sample_test, golden_point_set_compile)
 
     glkernel::sample::golden_point_set(dkernel2);
 }
+
+TEST_F(sample_test, golden_point_set_soa_matches_aos)
+{
+    auto fkernel2 = glkernel::kernel2{ 13, 7 };
+    glkernel::sample::golden_point_set(fkernel2, 42u);
+
+    auto soa = glkernel::tkernel<glm::vec2, glkernel::layout::soa>{ 13, 7 };
+    glkernel::sample::golden_point_set(soa, 42u);
+
+    for (size_t i = 0; i < fkernel2.size(); ++i)
+        EXPECT_EQ(fkernel2[i], static_cast<glm::vec2>(soa[i]));
+}
+
+TEST_F(sample_test, seeded_reproducible)
+{
+    auto fkernel2 = glkernel::kernel2{ 16, 16 };
+    auto reference = glkernel::kernel2{ 16, 16 };
+
+    glkernel::sample::poisson_square(fkernel2, 32u, 42u);
+    glkernel::sample::poisson_square(reference, 32u, 42u);
+    for (size_t i = 0; i < fkernel2.size(); ++i)
+        EXPECT_EQ(reference[i], fkernel2[i]);
+
+    glkernel::sample::multi_jittered(fkernel2, false, 42u);
+    glkernel::sample::multi_jittered(reference, false, 42u);
+    for (size_t i = 0; i < fkernel2.size(); ++i)
+        EXPECT_EQ(reference[i], fkernel2[i]);
+
+    glkernel::sample::n_rooks(fkernel2, 42u);
+    glkernel::sample::n_rooks(reference, 42u);
+    for (size_t i = 0; i < fkernel2.size(); ++i)
+        EXPECT_EQ(reference[i], fkernel2[i]);
+
+    glkernel::sample::stratified(fkernel2, 42u);
+    glkernel::sample::stratified(reference, 42u);
+    for (size_t i = 0; i < fkernel2.size(); ++i)
+        EXPECT_EQ(reference[i], fkernel2[i]);
+
+    glkernel::sample::best_candidate(fkernel2, 8u, 42u);
+    glkernel::sample::best_candidate(reference, 8u, 42u);
+    for (size_t i = 0; i < fkernel2.size(); ++i)
+        EXPECT_EQ(reference[i], fkernel2[i]);
+
+    glkernel::sample::golden_point_set(fkernel2, 42u);
+    glkernel::sample::golden_point_set(reference, 42u);
+    for (size_t i = 0; i < fkernel2.size(); ++i)
+        EXPECT_EQ(reference[i], fkernel2[i]);
+}
+
+TEST_F(sample_test, sobol_compile)
+{
+    auto fkernel1 = glkernel::kernel1{ 4 };
+    auto fkernel2 = glkernel::kernel2{ 4 };
+    auto fkernel3 = glkernel::kernel3{ 4 };
+    auto fkernel4 = glkernel::kernel4{ 4 };
+
+    glkernel::sample::sobol(fkernel1);
+    glkernel::sample::sobol(fkernel2);
+    glkernel::sample::sobol(fkernel3);
+    glkernel::sample::sobol(fkernel4, true, 42u);
+
+    auto dkernel2 = glkernel::dkernel2{ 4 };
+
+    glkernel::sample::sobol(dkernel2, true, 42u, 14);
+}
+
+TEST_F(sample_test, sobol_known_values)
+{
+    auto kernel = glkernel::kernel2{ 8 };
+
+    glkernel::sample::sobol(kernel, false, 0u);
+
+    const float x[] = { 0.f, 0.5f, 0.75f, 0.25f, 0.375f, 0.875f, 0.625f, 0.125f };
+    const float y[] = { 0.f, 0.5f, 0.25f, 0.75f, 0.375f, 0.875f, 0.125f, 0.625f };
+
+    for (size_t i = 0; i < kernel.size(); ++i)
+    {
+        EXPECT_FLOAT_EQ(x[i], kernel[i].x);
+        EXPECT_FLOAT_EQ(y[i], kernel[i].y);
+    }
+}
+
+TEST_F(sample_test, sobol_net)
+{
+    // the first 2^m points of the first two dimensions are a (0, m, 2)-net,
+    // i.e., each elementary interval of area 2^-m contains exactly one point
+    const glm::uint32 m = 12;
+
+    for (bool scrambled : { false, true })
+    {
+        auto kernel = glkernel::dkernel2{ 1u << m };
+
+        glkernel::sample::sobol(kernel, scrambled, 42u);
+
+        for (glm::uint32 k = 0; k <= m; ++k)
+        {
+            auto count = std::vector<int>(kernel.size(), 0);
+            for (size_t i = 0; i < kernel.size(); ++i)
+            {
+                const auto cell_x = static_cast<size_t>(kernel[i].x * (1u << k));
+                const auto cell_y = static_cast<size_t>(kernel[i].y * (1u << (m - k)));
+                ++count[cell_y * (1u << k) + cell_x];
+            }
+            EXPECT_EQ(kernel.size(), static_cast<size_t>(std::count(count.begin(), count.end(), 1)));
+        }
+    }
+}
+
+TEST_F(sample_test, sobol_dimensions_stratified)
+{
+    // every dimension on its own is stratified
+    for (unsigned int first_dimension = 0; first_dimension < glkernel::sample::sobol_dimensions; first_dimension += 4)
+    {
+        auto kernel = glkernel::kernel4{ 256 };
+
+        glkernel::sample::sobol(kernel, true, 7u, first_dimension);
+
+        for (glm::length_t c = 0; c < 4; ++c)
+        {
+            auto count = std::vector<int>(kernel.size(), 0);
+            for (size_t i = 0; i < kernel.size(); ++i)
+            {
+                ASSERT_LE(0.f, kernel[i][c]);
+                ASSERT_GT(1.f, kernel[i][c]);
+                ++count[static_cast<size_t>(kernel[i][c] * kernel.size())];
+            }
+            EXPECT_EQ(kernel.size(), static_cast<size_t>(std::count(count.begin(), count.end(), 1)));
+        }
+    }
+}
+
+double radical_inverse_reference(size_t index, const unsigned int base)
+{
+    auto result = 0.0;
+    auto scale = 1.0 / base;
+    for (; index > 0; index /= base, scale /= base)
+        result += (index % base) * scale;
+    return result;
+}
+
+TEST_F(sample_test, halton_batches_match_digit_expansion)
+{
+    // spans several batches and blocks of the tabulated low digits
+    auto halton = glkernel::dkernel2{ 20000 };
+    glkernel::sample::halton(halton, 3, 7);
+
+    auto halton_sphere = glkernel::dkernel3{ 20000 };
+    glkernel::sample::halton_sphere(halton_sphere, 5, 3);
+
+    auto hammersley_sphere = glkernel::dkernel3{ 20000 };
+    glkernel::sample::hammersley_sphere(hammersley_sphere, glkernel::sample::HemisphereMapping::Cosine);
+
+    for (size_t i = 0; i < halton.size(); ++i)
+    {
+        EXPECT_NEAR(radical_inverse_reference(i, 3), halton[i].x, 1e-12);
+        EXPECT_NEAR(radical_inverse_reference(i, 7), halton[i].y, 1e-12);
+
+        const auto phi = radical_inverse_reference(i, 3) * 2.0 * glm::pi<double>();
+        const auto cos_theta = 1.0 - radical_inverse_reference(i, 5);
+        const auto sin_theta = std::sqrt(1.0 - cos_theta * cos_theta);
+        EXPECT_NEAR(std::cos(phi) * sin_theta, halton_sphere[i].x, 1e-12);
+        EXPECT_NEAR(std::sin(phi) * sin_theta, halton_sphere[i].y, 1e-12);
+        EXPECT_NEAR(cos_theta, halton_sphere[i].z, 1e-12);
+
+        const auto phi2 = radical_inverse_reference(i, 2) * 2.0 * glm::pi<double>();
+        const auto cos_theta2 = std::sqrt(1.0 - static_cast<double>(i) / hammersley_sphere.size());
+        const auto sin_theta2 = std::sqrt(1.0 - cos_theta2 * cos_theta2);
+        EXPECT_NEAR(std::cos(phi2) * sin_theta2, hammersley_sphere[i].x, 1e-12);
+        EXPECT_NEAR(std::sin(phi2) * sin_theta2, hammersley_sphere[i].y, 1e-12);
+        EXPECT_NEAR(cos_theta2, hammersley_sphere[i].z, 1e-12);
+    }
+}
+
+TEST_F(sample_test, static_point_sets_match_runtime)
+{
+    // generated at compile time
+    static constexpr auto s_hammersley = glkernel::sample::hammersley<glkernel::static_kernel2<16>>();
+    static constexpr auto s_halton = glkernel::sample::halton<glkernel::static_kernel2<4, 4>>(2, 3);
+    static constexpr auto s_hammersley_sphere = glkernel::sample::hammersley_sphere<glkernel::static_kernel3<64>>();
+    static constexpr auto s_halton_sphere = glkernel::sample::halton_sphere<glkernel::static_dkernel3<32>>(2, 5, glkernel::sample::HemisphereMapping::Cosine);
+
+    static_assert(s_hammersley.component(1, 1) == 0.5f, "hammersley is expected to be a constant expression");
+
+    auto hammersley = glkernel::kernel2{ 16 };
+    glkernel::sample::hammersley(hammersley);
+
+    auto halton = glkernel::kernel2{ 4, 4 };
+    glkernel::sample::halton(halton, 2, 3);
+
+    for (size_t i = 0; i < hammersley.size(); ++i)
+    {
+        EXPECT_EQ(hammersley[i], s_hammersley[i]);
+        EXPECT_EQ(halton[i], s_halton[i]);
+    }
+
+    auto hammersley_sphere = glkernel::kernel3{ 64 };
+    glkernel::sample::hammersley_sphere(hammersley_sphere);
+
+    auto halton_sphere = glkernel::dkernel3{ 32 };
+    glkernel::sample::halton_sphere(halton_sphere, 2, 5, glkernel::sample::HemisphereMapping::Cosine);
+
+    for (size_t i = 0; i < hammersley_sphere.size(); ++i)
+        for (glm::length_t c = 0; c < 3; ++c)
+            EXPECT_NEAR(hammersley_sphere[i][c], s_hammersley_sphere[i][c], 1e-6f);
+
+    for (size_t i = 0; i < halton_sphere.size(); ++i)
+        for (glm::length_t c = 0; c < 3; ++c)
+            EXPECT_NEAR(halton_sphere[i][c], s_halton_sphere[i][c], 1e-14);
+}
+
+template <typename V>
+std::vector<V> best_candidate_brute_force(const size_t size, const unsigned int num_candidates, const glkernel::random::seed_type seed)
+{
+    using T = typename V::value_type;
+
+    auto samples = std::vector<V>{ };
+    for (size_t k = 0; k < size; ++k)
+    {
+        auto best = V{ };
+        auto best_dist = T{ -1 };
+        for (unsigned int c = 0; c < num_candidates; ++c)
+        {
+            auto generator = glkernel::random::philox_engine{ seed, k, c };
+
+            auto candidate = V{ };
+            for (glm::length_t i = 0; i < V::length(); ++i)
+                candidate[i] = glkernel::random::uniform<T>(generator);
+
+            auto min_squared = static_cast<T>(V::length());
+            for (const auto & sample : samples)
+                min_squared = std::min(min_squared, glm::length2(candidate - sample));
+
+            if (min_squared > best_dist)
+            {
+                best_dist = min_squared;
+                best = candidate;
+            }
+        }
+        samples.push_back(best);
+    }
+    return samples;
+}
+
+TEST_F(sample_test, best_candidate_matches_brute_force)
+{
+    // the nearest neighbor grid yields the exact same samples as testing against all samples
+    auto fkernel2 = glkernel::kernel2{ 23, 17 };
+    glkernel::sample::best_candidate(fkernel2, 16u, 7u);
+
+    const auto expected2 = best_candidate_brute_force<glm::vec2>(fkernel2.size(), 16u, 7u);
+    for (size_t i = 0; i < fkernel2.size(); ++i)
+        EXPECT_EQ(expected2[i], fkernel2[i]);
+
+    auto dkernel3 = glkernel::dkernel3{ 9, 7, 5 };
+    glkernel::sample::best_candidate(dkernel3, 8u, 11u);
+
+    const auto expected3 = best_candidate_brute_force<glm::dvec3>(dkernel3.size(), 8u, 11u);
+    for (size_t i = 0; i < dkernel3.size(); ++i)
+        EXPECT_EQ(expected3[i], dkernel3[i]);
+}
+
+template <typename Kernel, typename T>
+T poisson_min_toroidal_distance(const Kernel & kernel, const size_t count)
+{
+    auto min_dist = static_cast<T>(2);
+    for (size_t i = 0; i < count; ++i)
+        for (size_t j = i + 1; j < count; ++j)
+        {
+            auto delta = glm::abs(kernel[i] - kernel[j]);
+            delta = glm::min(delta, static_cast<T>(1) - delta);
+            min_dist = std::min(min_dist, std::sqrt(glm::dot(delta, delta)));
+        }
+    return min_dist;
+}
+
+TEST_F(sample_test, poisson_square_min_dist)
+{
+    auto fkernel2 = glkernel::kernel2{ 32, 32 };
+    const auto count = glkernel::sample::poisson_square(fkernel2, 0.02f, 32u, 3u);
+
+    EXPECT_GT(count, 0u);
+    const auto min_dist = poisson_min_toroidal_distance<glkernel::kernel2, float>(fkernel2, count);
+    EXPECT_GE(min_dist, 0.02f * (1.f - 1e-5f));
+}
+
+TEST_F(sample_test, poisson_square_parallel_min_dist)
+{
+    auto fkernel2 = glkernel::kernel2{ 64, 64 };
+    const auto count = glkernel::sample::poisson_square_parallel(fkernel2, 0.015f, 32u, 3u);
+
+    // a maximal sampling covers the square with about 0.7 / min_dist^2 samples
+    EXPECT_GT(count, 2000u);
+    EXPECT_LE(count, fkernel2.size());
+    const auto min_dist = poisson_min_toroidal_distance<glkernel::kernel2, float>(fkernel2, count);
+    EXPECT_GE(min_dist, 0.015f * (1.f - 1e-5f));
+
+    // independent of thread scheduling
+    auto reference = glkernel::kernel2{ 64, 64 };
+    EXPECT_EQ(count, glkernel::sample::poisson_square_parallel(reference, 0.015f, 32u, 3u));
+    for (size_t i = 0; i < count; ++i)
+        EXPECT_EQ(reference[i], fkernel2[i]);
+
+    // kernel too small for all samples keeps a subset
+    auto dkernel2 = glkernel::dkernel2{ 16, 16 };
+    EXPECT_EQ(dkernel2.size(), glkernel::sample::poisson_square_parallel(dkernel2, 0.015, 32u, 3u));
+}
+
+TEST_F(sample_test, poisson_square_large_min_dist)
+{
+    // min_dist spans between sqrt(2) and two cells of the occupancy grid, so conflicts with the corner cells
+    // of the 5x5 neighborhood are possible
+    for (const auto min_dist : { 0.1f, 0.15f, 0.2f, 0.25f, 0.3f })
+        for (auto seed = 1u; seed <= 16u; ++seed)
+        {
+            auto fkernel2 = glkernel::kernel2{ 16, 16 };
+            auto count = glkernel::sample::poisson_square(fkernel2, min_dist, 32u, seed);
+            const auto sequential = poisson_min_toroidal_distance<glkernel::kernel2, float>(fkernel2, count);
+            EXPECT_GE(sequential, min_dist * (1.f - 1e-5f));
+
+            count = glkernel::sample::poisson_square_parallel(fkernel2, min_dist, 32u, seed);
+            const auto parallel = poisson_min_toroidal_distance<glkernel::kernel2, float>(fkernel2, count);
+            EXPECT_GE(parallel, min_dist * (1.f - 1e-5f));
+        }
+}
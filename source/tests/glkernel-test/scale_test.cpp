@@ -37,3 +37,22 @@ TEST_F(scale_test, range)
     EXPECT_FLOAT_EQ(-.1f, fkernel2[3][0]);
     EXPECT_FLOAT_EQ(.3f, fkernel2[3][1]);
 }
+
+TEST_F(scale_test, range_soa)
+{
+    auto fkernel2 = glkernel::tkernel<glm::vec2, glkernel::layout::soa>{ 2, 2 };
+    fkernel2[0] = {6, 7};
+    fkernel2[1] = {5, 9};
+    fkernel2[2] = {10, 8};
+    fkernel2[3] = {7, 9};
+    glkernel::scale::range(fkernel2, -0.5f, 0.5f, 5.f, 10.f);
+
+    EXPECT_FLOAT_EQ(-.3f, fkernel2[0][0]);
+    EXPECT_FLOAT_EQ(-.1f, fkernel2[0][1]);
+    EXPECT_FLOAT_EQ(-.5f, fkernel2[1][0]);
+    EXPECT_FLOAT_EQ(.3f, fkernel2[1][1]);
+    EXPECT_FLOAT_EQ(.5f, fkernel2[2][0]);
+    EXPECT_FLOAT_EQ(.1f, fkernel2[2][1]);
+    EXPECT_FLOAT_EQ(-.1f, fkernel2[3][0]);
+    EXPECT_FLOAT_EQ(.3f, fkernel2[3][1]);
+}
@@ -77,3 +77,35 @@ TEST_F(sequence_test, uniform_distribution)
     EXPECT_FLOAT_EQ(7.f / 2.f, fkernel4[1][3]);
     EXPECT_FLOAT_EQ(8.f / 2.f, fkernel4[2][3]);
 }
+
+TEST_F(sequence_test, uniform_distribution_chunked)
+{
+    // covers multiple chunks, including a partial one at the end
+    auto fkernel1 = glkernel::kernel1{ 1021, 3 };
+
+    glkernel::sequence::uniform(fkernel1, 0.f, 1.f);
+
+    for (size_t i = 0; i < fkernel1.size(); ++i)
+        EXPECT_FLOAT_EQ(static_cast<float>(i) / (fkernel1.size() - 1), fkernel1[i]);
+
+    auto fkernel3 = glkernel::kernel3{ 257, 5 };
+
+    glkernel::sequence::uniform(fkernel3, glm::vec3{ 0.f, 1.f, 2.f }, glm::vec3{ 1.f, 2.f, 3.f });
+
+    for (size_t i = 0; i < fkernel3.size(); ++i)
+        for (glm::length_t c = 0; c < 3; ++c)
+            EXPECT_FLOAT_EQ(c + static_cast<float>(i) / (fkernel3.size() - 1), fkernel3[i][c]);
+}
+
+TEST_F(sequence_test, uniform_distribution_large_1d)
+{
+    // 1D sequences exceed the former 16 bit extent limit
+    auto dkernel1 = glkernel::dkernel1{ 100000 };
+    EXPECT_EQ(100000u, dkernel1.width());
+
+    glkernel::sequence::uniform(dkernel1, 0.0, 1.0);
+
+    EXPECT_DOUBLE_EQ(0.0, dkernel1[0]);
+    EXPECT_DOUBLE_EQ(50000.0 / 99999.0, dkernel1[50000]);
+    EXPECT_DOUBLE_EQ(1.0, dkernel1[99999]);
+}
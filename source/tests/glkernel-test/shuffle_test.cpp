@@ -1,6 +1,7 @@
 
 #include <gmock/gmock.h>
 
+#include <vector>
 
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
@@ -8,6 +9,7 @@
 
 #include <glkernel/Kernel.h>
 #include <glkernel/shuffle.h>
+#include <glkernel/sequence.h>
 
 
 class shuffle_test: public testing::Test
@@ -50,3 +52,279 @@ TEST_F(shuffle_test, random_compile)
     auto fkernel4 = glkernel::kernel4{ 4, 4 };
     glkernel::shuffle::random(fkernel4);
 }
+
+TEST_F(shuffle_test, random_seeded)
+{
+    auto fkernel1 = glkernel::kernel1{ 16, 16 };
+    for (size_t i = 0; i < fkernel1.size(); ++i)
+        fkernel1[i] = static_cast<float>(i);
+
+    auto reference = fkernel1;
+
+    glkernel::shuffle::random(fkernel1, 1, 42u);
+    glkernel::shuffle::random(reference, 1, 42u);
+
+    EXPECT_EQ(0.f, fkernel1[0]);
+    for (size_t i = 0; i < fkernel1.size(); ++i)
+        EXPECT_EQ(reference[i], fkernel1[i]);
+}
+
+TEST_F(shuffle_test, random_soa_matches_aos)
+{
+    // large enough for shuffled blocks to be merged
+    auto fkernel2 = glkernel::kernel2{ 300, 300 };
+    auto soa = glkernel::tkernel<glm::vec2, glkernel::layout::soa>{ 300, 300 };
+    for (size_t i = 0; i < fkernel2.size(); ++i)
+    {
+        fkernel2[i] = glm::vec2(static_cast<float>(i), -static_cast<float>(i));
+        soa[i] = fkernel2[i];
+    }
+
+    glkernel::shuffle::random(fkernel2, 1, 42u);
+    glkernel::shuffle::random(soa, 1, 42u);
+
+    for (size_t i = 0; i < fkernel2.size(); ++i)
+        EXPECT_EQ(fkernel2[i], static_cast<glm::vec2>(soa[i]));
+}
+
+TEST_F(shuffle_test, random_large)
+{
+    // two blocks of 2^16 values and a partial third block, merged in two levels
+    auto fkernel1 = glkernel::kernel1{ 512, 257 };
+    auto reference = glkernel::kernel4{ 512, 257 };
+
+    for (const auto seed : { 1u, 2u, 3u, 4u })
+    {
+        for (size_t i = 0; i < fkernel1.size(); ++i)
+        {
+            fkernel1[i] = static_cast<float>(i);
+            reference[i] = glm::vec4(static_cast<float>(i));
+        }
+
+        glkernel::shuffle::random(fkernel1, 0, seed);
+        glkernel::shuffle::random(reference, 0, seed);
+
+        auto occurrences = std::vector<int>(fkernel1.size(), 0);
+        for (size_t i = 0; i < fkernel1.size(); ++i)
+        {
+            EXPECT_EQ(glm::vec4(fkernel1[i]), reference[i]);
+            ++occurrences[static_cast<size_t>(fkernel1[i])];
+        }
+        for (const auto occurrence : occurrences)
+            ASSERT_EQ(1, occurrence);
+
+        // about a quarter of the first quarter's values remain there (hypergeometric, sigma of about 70)
+        const auto quarter = fkernel1.size() / 4;
+        auto remaining = 0;
+        for (size_t i = 0; i < quarter; ++i)
+            remaining += fkernel1[i] < static_cast<float>(quarter) ? 1 : 0;
+
+        EXPECT_NEAR(static_cast<double>(quarter) / 4.0, static_cast<double>(remaining), 420.0);
+    }
+}
+
+TEST_F(shuffle_test, bucket_permutate_seeded)
+{
+    auto fkernel1 = glkernel::kernel1{ 8, 8 };
+    for (size_t i = 0; i < fkernel1.size(); ++i)
+        fkernel1[i] = static_cast<float>(i);
+
+    auto reference = fkernel1;
+
+    glkernel::shuffle::bucket_permutate(fkernel1, 2, 2, 1, true, 42u);
+    glkernel::shuffle::bucket_permutate(reference, 2, 2, 1, true, 42u);
+
+    for (size_t i = 0; i < fkernel1.size(); ++i)
+        EXPECT_EQ(reference[i], fkernel1[i]);
+}
+
+TEST_F(shuffle_test, permutation_plan_matches_bucket_permutate)
+{
+    auto fkernel1 = glkernel::kernel1{ 12, 8, 2 };
+    for (size_t i = 0; i < fkernel1.size(); ++i)
+        fkernel1[i] = static_cast<float>(i);
+
+    const auto source = fkernel1;
+    auto gathered = glkernel::kernel1{ 12, 8, 2 };
+
+    for (const auto per_bucket : { false, true })
+    {
+        const auto plan = glkernel::shuffle::permutation_plan{ fkernel1.extent(), glm::u32vec3(4, 2, 1), per_bucket, 7u };
+        EXPECT_EQ(fkernel1.size(), plan.size());
+
+        auto reference = source;
+        glkernel::shuffle::bucket_permutate(reference, 4, 2, 1, per_bucket, 7u);
+
+        fkernel1 = source;
+        plan.apply(fkernel1);
+        plan.apply(source, gathered);
+
+        for (size_t i = 0; i < fkernel1.size(); ++i)
+        {
+            EXPECT_EQ(reference[i], fkernel1[i]);
+            EXPECT_EQ(reference[i], gathered[i]);
+            EXPECT_EQ(source[plan[i]], fkernel1[i]);
+        }
+    }
+}
+
+TEST_F(shuffle_test, permutation_plan_buckets)
+{
+    // 8 sub-kernels of 3x2x2 values, i.e., 12 buckets of 8 values
+    const auto extent = glm::u32vec3(6, 4, 4);
+    const auto subkernel = glm::u32vec3(3, 2, 2);
+    const auto num_subkernels = size_t{ 8 };
+
+    for (const auto per_bucket : { false, true })
+    {
+        auto fkernel1 = glkernel::kernel1{ extent.x, extent.y, extent.z };
+        for (size_t i = 0; i < fkernel1.size(); ++i)
+            fkernel1[i] = static_cast<float>(i);
+
+        glkernel::shuffle::permutation_plan{ extent, subkernel, per_bucket, 3u }.apply(fkernel1);
+
+        // every value occurs once
+        auto occurrences = std::vector<int>(fkernel1.size(), 0);
+        for (size_t i = 0; i < fkernel1.size(); ++i)
+            ++occurrences[static_cast<size_t>(fkernel1[i])];
+        for (const auto occurrence : occurrences)
+            EXPECT_EQ(1, occurrence);
+
+        // every sub-kernel comprises one value of each bucket
+        for (glm::uint32 z = 0; z < extent.z; z += subkernel.z)
+        for (glm::uint32 y = 0; y < extent.y; y += subkernel.y)
+        for (glm::uint32 x = 0; x < extent.x; x += subkernel.x)
+        {
+            auto buckets = std::vector<int>(12, 0);
+            for (glm::uint32 d = 0; d < subkernel.z; ++d)
+            for (glm::uint32 h = 0; h < subkernel.y; ++h)
+            for (glm::uint32 w = 0; w < subkernel.x; ++w)
+                ++buckets[static_cast<size_t>(fkernel1.value(x + w, y + h, z + d)) / num_subkernels];
+
+            for (const auto bucket : buckets)
+                EXPECT_EQ(1, bucket);
+        }
+    }
+}
+
+TEST_F(shuffle_test, permutation_plan_views)
+{
+    auto fkernel2 = glkernel::kernel2{ 8, 8 };
+    for (size_t i = 0; i < fkernel2.size(); ++i)
+        fkernel2[i] = glm::vec2(static_cast<float>(i), -static_cast<float>(i));
+
+    const auto plan = glkernel::shuffle::permutation_plan{ fkernel2.extent(), glm::u32vec3(2, 2, 1), true, 5u };
+
+    // gather into external memory, and permutate a soa kernel in place
+    auto memory = std::vector<glm::vec2>(fkernel2.size());
+    auto fview = glkernel::kernel2_view(memory.data(), 8, 8);
+    plan.apply(fkernel2, fview);
+
+    auto soa = glkernel::tkernel<glm::vec2, glkernel::layout::soa>{ 8, 8 };
+    for (size_t i = 0; i < soa.size(); ++i)
+        soa[i] = fkernel2[i];
+    plan.apply(soa);
+
+    glkernel::shuffle::bucket_permutate(fkernel2, 2, 2, 1, true, 5u);
+
+    for (size_t i = 0; i < fkernel2.size(); ++i)
+    {
+        EXPECT_EQ(fkernel2[i], memory[i]);
+        EXPECT_EQ(fkernel2[i], static_cast<glm::vec2>(soa[i]));
+    }
+}
+
+TEST_F(shuffle_test, bayer_static)
+{
+    // constant dither matrix of thresholds in [0, 1]
+    static constexpr auto s_bayer = glkernel::shuffle::bayer(glkernel::sequence::uniform<glkernel::static_kernel1<8, 8>>(0.f, 1.f));
+    static_assert(s_bayer.component(1, 0) == 48.f / 63.f, "bayer is expected to be a constant expression");
+
+    auto fkernel1 = glkernel::kernel1{ 8, 8 };
+    glkernel::sequence::uniform(fkernel1, 0.f, 1.f);
+    glkernel::shuffle::bayer(fkernel1);
+
+    for (size_t i = 0; i < fkernel1.size(); ++i)
+        EXPECT_EQ(fkernel1[i], s_bayer[i]);
+
+    EXPECT_EQ(s_bayer.data()[s_bayer.index(1, 1)], fkernel1.value(1, 1));
+}
+
+TEST_F(shuffle_test, bayer_recursive)
+{
+    static_assert(glkernel::shuffle::bayer_rank(1, 0, 0, 2, 2) == 2, "bayer_rank is expected to be a constant expression");
+
+    // recursive matrices match the classic 2x2 and 4x4 matrices, and 1D matrices the bit-reversed indices
+    const glm::uint32 bayer4[] = { 0, 8, 2, 10, 12, 4, 14, 6, 3, 11, 1, 9, 15, 7, 13, 5 };
+    for (glm::uint32 i = 0; i < 16; ++i)
+        EXPECT_EQ(bayer4[i], glkernel::shuffle::bayer_rank(i % 4, i / 4, 0, 4, 4));
+
+    const glm::uint32 reversed[] = { 0, 4, 2, 6, 1, 5, 3, 7 };
+    for (glm::uint32 i = 0; i < 8; ++i)
+        EXPECT_EQ(reversed[i], glkernel::shuffle::bayer_rank(i, 0, 0, 8));
+
+    // 256x256 dither mask, 3D (spatio-temporal) masks, and non-square masks, also of the classic matrices' sizes
+    for (const auto & extent : { glm::u32vec3(256, 256, 1), glm::u32vec3(8, 8, 4), glm::u32vec3(32, 4, 1), glm::u32vec3(2, 16, 8)
+        , glm::u32vec3(4, 4, 4), glm::u32vec3(16, 4, 1), glm::u32vec3(64, 1, 1), glm::u32vec3(32, 2, 1), glm::u32vec3(8, 2, 1)
+        , glm::u32vec3(4, 1, 1), glm::u32vec3(1, 2, 2) })
+    {
+        auto fkernel1 = glkernel::kernel1{ extent.x, extent.y, extent.z };
+        for (size_t i = 0; i < fkernel1.size(); ++i)
+            fkernel1[i] = static_cast<float>(i);
+
+        glkernel::shuffle::bayer(fkernel1);
+
+        const auto size = fkernel1.size();
+        const auto axes = (extent.x > 1 ? 1 : 0) + (extent.y > 1 ? 1 : 0) + (extent.z > 1 ? 1 : 0);
+
+        auto occurrences = std::vector<int>(size, 0);
+        for (glm::uint32 z = 0; z < extent.z; ++z)
+        for (glm::uint32 y = 0; y < extent.y; ++y)
+        for (glm::uint32 x = 0; x < extent.x; ++x)
+        {
+            const auto rank = static_cast<size_t>(fkernel1.value(x, y, z));
+            EXPECT_EQ(rank, glkernel::shuffle::bayer_rank(x, y, z, extent.x, extent.y, extent.z));
+            ++occurrences[rank];
+
+            // the lowest ranks are spread over the coarsest grid, followed by the antipodal grid
+            if (rank < (size >> axes))
+            {
+                EXPECT_EQ(0u, (x | y | z) & 1u);
+            }
+            else if (rank < 2 * (size >> axes))
+            {
+                EXPECT_TRUE(extent.x == 1 || (x & 1u) == 1u);
+                EXPECT_TRUE(extent.y == 1 || (y & 1u) == 1u);
+                EXPECT_TRUE(extent.z == 1 || (z & 1u) == 1u);
+            }
+        }
+        for (const auto occurrence : occurrences)
+            ASSERT_EQ(1, occurrence);
+    }
+
+    // remap of any element type, and unsupported extents remain unchanged
+    auto fkernel4 = glkernel::kernel4{ 16, 8 };
+    for (size_t i = 0; i < fkernel4.size(); ++i)
+        fkernel4[i] = glm::vec4(static_cast<float>(i));
+    glkernel::shuffle::bayer(fkernel4);
+    EXPECT_EQ(glm::vec4(static_cast<float>(glkernel::shuffle::bayer_rank(3, 5, 0, 16, 8))), fkernel4.value(3, 5));
+
+    for (const auto & extent : { glm::u32vec3(12, 8, 1), glm::u32vec3(9, 1, 1), glm::u32vec3(3, 3, 3) })
+    {
+        auto fkernel1 = glkernel::kernel1{ extent.x, extent.y, extent.z };
+        for (size_t i = 0; i < fkernel1.size(); ++i)
+            fkernel1[i] = static_cast<float>(i);
+        glkernel::shuffle::bayer(fkernel1);
+        for (size_t i = 0; i < fkernel1.size(); ++i)
+            EXPECT_EQ(static_cast<float>(i), fkernel1[i]);
+    }
+
+    // the compile-time variant remaps non-square and 3D extents alike
+    static constexpr auto s_bayer16x4 = glkernel::shuffle::bayer(glkernel::sequence::uniform<glkernel::static_kernel1<16, 4>>(0.f, 63.f));
+    static constexpr auto s_bayer4x4x4 = glkernel::shuffle::bayer(glkernel::sequence::uniform<glkernel::static_kernel1<4, 4, 4>>(0.f, 63.f));
+    for (glm::uint32 i = 0; i < 64; ++i)
+    {
+        EXPECT_EQ(static_cast<float>(glkernel::shuffle::bayer_rank(i % 16, i / 16, 0, 16, 4)), s_bayer16x4[i]);
+        EXPECT_EQ(static_cast<float>(glkernel::shuffle::bayer_rank(i % 4, i / 4 % 4, i / 16, 4, 4, 4)), s_bayer4x4x4[i]);
+    }
+}
@@ -2,7 +2,12 @@
 #include <gmock/gmock.h>
 
 
+#include <algorithm>
+#include <vector>
+
 #include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/gtc/constants.hpp>
 
 #include <glkernel/Kernel.h>
 #include <glkernel/sort.h>
@@ -37,3 +42,165 @@ TEST_F(sort_test, distance_sorted)
     EXPECT_FLOAT_EQ(3.f, fkernel2[3][0]);
     EXPECT_FLOAT_EQ(3.f, fkernel2[3][1]);
 }
+
+TEST_F(sort_test, distance_sorted_view)
+{
+    // 2x2 values with rows padded to 3 values
+    auto memory = std::vector<glm::vec2>{ { 3, 3 }, { 1, 1 }, { 9, 9 }, { 2, 0 }, { -4, 0 }, { 9, 9 } };
+    auto fview = glkernel::kernel2_view{ memory.data(), 2, 2, 1, 3 * sizeof(glm::vec2) };
+    glkernel::sort::distance(fview, {0, 0});
+
+    EXPECT_EQ(glm::vec2( 1, 1), memory[0]);
+    EXPECT_EQ(glm::vec2( 2, 0), memory[1]);
+    EXPECT_EQ(glm::vec2( 9, 9), memory[2]);
+    EXPECT_EQ(glm::vec2(-4, 0), memory[3]);
+    EXPECT_EQ(glm::vec2( 3, 3), memory[4]);
+    EXPECT_EQ(glm::vec2( 9, 9), memory[5]);
+}
+
+TEST_F(sort_test, distance_stable_large)
+{
+    // more values than sorted by a single chunk, with many equal distances on an integer grid
+    auto fkernel3 = glkernel::kernel3{ 300, 300 };
+    for (size_t i = 0; i < fkernel3.size(); ++i)
+        fkernel3[i] = glm::vec3(static_cast<float>(i % 17) - 8.f, static_cast<float>(i * 7 % 13) - 6.f, static_cast<float>(i % 300) * 0.5f);
+
+    const auto origin = glm::vec3(0.5f, -1.f, 20.f);
+
+    auto reference = std::vector<glm::vec3>(fkernel3.begin(), fkernel3.end());
+    std::stable_sort(reference.begin(), reference.end(), [&origin](const glm::vec3 & a, const glm::vec3 & b)
+    {
+        return glm::dot(a - origin, a - origin) < glm::dot(b - origin, b - origin);
+    });
+
+    glkernel::sort::distance(fkernel3, origin);
+
+    for (size_t i = 0; i < fkernel3.size(); ++i)
+        ASSERT_EQ(reference[i], fkernel3[i]);
+}
+
+TEST_F(sort_test, distance_scalar)
+{
+    auto dkernel1 = glkernel::dkernel1{ 6 };
+    const double values[] = { 3.0, -2.5, 1e-300, 1e300, -7.0, 0.0 };
+    for (size_t i = 0; i < dkernel1.size(); ++i)
+        dkernel1[i] = values[i];
+
+    glkernel::sort::distance(dkernel1, 0.5);
+
+    const double expected[] = { 1e-300, 0.0, 3.0, -2.5, -7.0, 1e300 };
+    for (size_t i = 0; i < dkernel1.size(); ++i)
+        EXPECT_EQ(expected[i], dkernel1[i]);
+}
+
+TEST_F(sort_test, by_key_morton)
+{
+    // 4x4 grid points in the lowest cells of [0, 2^16]^2, in reverse row-major order
+    auto fkernel2 = glkernel::kernel2{ 4, 4 };
+    for (size_t i = 0; i < fkernel2.size(); ++i)
+        fkernel2[i] = glm::vec2(static_cast<float>((15 - i) % 4), static_cast<float>((15 - i) / 4));
+
+    const auto permutation = glkernel::sort::by_key(fkernel2, glkernel::sort::morton<glm::vec2>{ glm::vec2(0.f), glm::vec2(65536.f) });
+
+    const glm::vec2 expected[] = { { 0, 0 }, { 1, 0 }, { 0, 1 }, { 1, 1 }, { 2, 0 }, { 3, 0 }, { 2, 1 }, { 3, 1 } };
+    for (size_t i = 0; i < 8; ++i)
+        EXPECT_EQ(expected[i], fkernel2[i]);
+
+    ASSERT_EQ(fkernel2.size(), permutation.size());
+    for (size_t i = 0; i < fkernel2.size(); ++i)
+        EXPECT_EQ(15 - permutation[i], static_cast<glm::uint32>(fkernel2[i].y * 4 + fkernel2[i].x));
+
+    // clamped to the bounds
+    const auto morton3 = glkernel::sort::morton<glm::vec3>{};
+    EXPECT_EQ(0u, morton3(glm::vec3(-1.f)));
+    EXPECT_EQ((glm::uint64{ 1 } << 63u) - 1u, morton3(glm::vec3(2.f)));
+}
+
+TEST_F(sort_test, by_key_hilbert)
+{
+    // consecutive cells along the curve are adjacent, for 8x8 and 4x4x4 grid points
+    auto fkernel2 = glkernel::kernel2{ 8, 8 };
+    for (size_t i = 0; i < fkernel2.size(); ++i)
+        fkernel2[i] = glm::vec2(static_cast<float>(i % 8), static_cast<float>(i / 8));
+
+    glkernel::sort::by_key(fkernel2, glkernel::sort::hilbert<glm::vec2>{ glm::vec2(0.f), glm::vec2(65536.f) });
+
+    EXPECT_EQ(glm::vec2(0.f), fkernel2[0]);
+    for (size_t i = 1; i < fkernel2.size(); ++i)
+        EXPECT_EQ(1.f, glm::abs(fkernel2[i].x - fkernel2[i - 1].x) + glm::abs(fkernel2[i].y - fkernel2[i - 1].y));
+
+    auto dkernel3 = glkernel::dkernel3{ 4, 4, 4 };
+    for (size_t i = 0; i < dkernel3.size(); ++i)
+        dkernel3[i] = glm::dvec3(dkernel3.position(i)) / 2097152.0;
+
+    glkernel::sort::by_key(dkernel3, glkernel::sort::hilbert<glm::dvec3>{});
+
+    for (size_t i = 1; i < dkernel3.size(); ++i)
+    {
+        const auto step = glm::abs(dkernel3[i] - dkernel3[i - 1]) * 2097152.0;
+        EXPECT_DOUBLE_EQ(1.0, step.x + step.y + step.z);
+    }
+}
+
+TEST_F(sort_test, by_key_angle_projection)
+{
+    auto fkernel2 = glkernel::kernel2{ 16 };
+    for (size_t i = 0; i < fkernel2.size(); ++i)
+    {
+        const auto a = static_cast<float>(i * 7 % 16) / 16.f * glm::two_pi<float>() - glm::pi<float>();
+        fkernel2[i] = glm::vec2(1.f, 2.f) + glm::vec2(std::cos(a), std::sin(a));
+    }
+
+    const auto angle = glkernel::sort::angle<glm::vec2>{ glm::vec2(1.f, 2.f) };
+    glkernel::sort::by_key(fkernel2, angle);
+
+    for (size_t i = 1; i < fkernel2.size(); ++i)
+        EXPECT_LT(angle(fkernel2[i - 1]), angle(fkernel2[i]));
+
+    // colors by luminance, and a companion kernel reordered by the permutation
+    auto fkernel3 = glkernel::kernel3{ 4 };
+    fkernel3[0] = glm::vec3(1.f, 1.f, 1.f);
+    fkernel3[1] = glm::vec3(0.f, 0.f, 1.f);
+    fkernel3[2] = glm::vec3(0.f, 1.f, 0.f);
+    fkernel3[3] = glm::vec3(1.f, 0.f, 0.f);
+
+    auto fkernel1 = glkernel::kernel1{ 4 };
+    for (size_t i = 0; i < fkernel1.size(); ++i)
+        fkernel1[i] = static_cast<float>(i);
+
+    const auto permutation = glkernel::sort::by_key(fkernel3, glkernel::sort::projection<glm::vec3>{ glm::vec3(0.2126f, 0.7152f, 0.0722f) });
+    glkernel::sort::reorder(fkernel1, permutation);
+
+    EXPECT_EQ(glm::vec3(0.f, 0.f, 1.f), fkernel3[0]);
+    EXPECT_EQ(glm::vec3(1.f, 0.f, 0.f), fkernel3[1]);
+    EXPECT_EQ(glm::vec3(0.f, 1.f, 0.f), fkernel3[2]);
+    EXPECT_EQ(glm::vec3(1.f, 1.f, 1.f), fkernel3[3]);
+
+    const float expected[] = { 1.f, 3.f, 2.f, 0.f };
+    for (size_t i = 0; i < fkernel1.size(); ++i)
+        EXPECT_EQ(expected[i], fkernel1[i]);
+}
+
+TEST_F(sort_test, by_key_companion)
+{
+    // negative and equal keys, the latter keeping their order
+    auto fkernel4 = glkernel::kernel4{ 5 };
+    for (size_t i = 0; i < fkernel4.size(); ++i)
+        fkernel4[i] = glm::vec4(static_cast<float>(i));
+
+    auto keys = glkernel::kernel1{ 5 };
+    keys[0] = 2.f;
+    keys[1] = -1.f;
+    keys[2] = -3.5f;
+    keys[3] = 2.f;
+    keys[4] = 0.f;
+
+    const auto permutation = glkernel::sort::by_key(fkernel4, keys);
+
+    const glm::uint32 expected[] = { 2, 1, 4, 0, 3 };
+    for (size_t i = 0; i < fkernel4.size(); ++i)
+    {
+        EXPECT_EQ(expected[i], permutation[i]);
+        EXPECT_EQ(glm::vec4(static_cast<float>(expected[i])), fkernel4[i]);
+    }
+}
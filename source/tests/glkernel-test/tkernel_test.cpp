@@ -1,231 +1,378 @@
-
-#include <gmock/gmock.h>
-
-
-#include <glm/vec2.hpp>
-#include <glm/vec3.hpp>
-#include <glm/vec4.hpp>
-
-#include <glkernel/Kernel.h>
-
-
-class tkernel_test: public testing::Test
- {
- public:
- };
-
-TEST_F(tkernel_test, tkernel_indexed_value_access)
-{
-    auto fkernel = glkernel::kernel1(2, 4, 8);
-
-    EXPECT_EQ(64u, fkernel.size());
-    EXPECT_EQ( 2u, fkernel.width());
-    EXPECT_EQ( 4u, fkernel.height());
-    EXPECT_EQ( 8u, fkernel.depth());
-
-    // check if a value set in kernel via spatial reference 
-    // equals the value at the expected index ...
-
-    const auto findex = fkernel.index(1, 2, 3);
-    EXPECT_EQ(static_cast<unsigned int>(2 * 4 * 3 + 2 * 2 + 1), findex);
-
-    fkernel[findex] = 1.f;
-    EXPECT_EQ(1.f, fkernel.value(1, 2, 3));
-}
-
-TEST_F(tkernel_test, tkernel_position_conformance)
-{
-    auto fkernel = glkernel::kernel1(2, 3, 4);
-
-    EXPECT_EQ(24u, fkernel.size());
-    EXPECT_EQ(2u, fkernel.width());
-    EXPECT_EQ(3u, fkernel.height());
-    EXPECT_EQ(4u, fkernel.depth());
-
-    // check if the index-position relation is bijectiv
-
-    const auto findex = fkernel.index(1, 2, 3);
-    EXPECT_EQ(static_cast<unsigned int>(2 * 3 * 3 + 2 * 2 + 1), findex);
-
-    fkernel[findex] = 1.f;
-    EXPECT_EQ(1.f, fkernel.value(1, 2, 3));
-
-    const auto fpos = fkernel.position(findex);
-    EXPECT_EQ(1u, fpos[0]);
-    EXPECT_EQ(2u, fpos[1]);
-    EXPECT_EQ(3u, fpos[2]);
-}
-
-TEST_F(tkernel_test, tkernel_data_access)
-{
-    auto fkernel = glkernel::kernel1(8, 2, 4);
-
-    EXPECT_EQ(64u, fkernel.size());
-    EXPECT_EQ( 8u, fkernel.width());
-    EXPECT_EQ( 2u, fkernel.height());
-    EXPECT_EQ( 4u, fkernel.depth());
-
-    // check if a value set in kernel via spatial reference 
-    // equals the value at the expected index ...
-
-    const auto findex = fkernel.index(2, 1, 3);
-    EXPECT_EQ(static_cast<unsigned int>(8 * 2 * 3 + 8 * 1 + 2), findex);
-
-    fkernel[findex] = 1.f;
-    EXPECT_EQ(1.f, fkernel.data()[findex]);
-}
-
-TEST_F(tkernel_test, tkernel_reset)
-{
-    auto fkernel = glkernel::kernel1(1024);
-
-    EXPECT_EQ(1024u, fkernel.size());
-    EXPECT_EQ(1024u, fkernel.width());
-    EXPECT_EQ(   1u, fkernel.height());
-    EXPECT_EQ(   1u, fkernel.depth());
-
-    {   auto accum = 0.f; // checksum
-        for (size_t i = 0; i < fkernel.size(); accum += fkernel[i++]);
-        EXPECT_EQ(0.f, accum);   }
-
-    for (size_t i = 0; i < fkernel.size(); ++i)
-        fkernel[i] = 1.0f;
-
-    {   auto accum = 0.f; // checksum
-        for (size_t i = 0; i < fkernel.size(); accum += fkernel[i++]);
-        EXPECT_EQ(static_cast<float>(fkernel.size()), accum);   }
-
-    fkernel.reset();
-
-    {   auto accum = 0.f; // checksum
-        for (size_t i = 0; i < fkernel.size(); accum += fkernel[i++]);
-        EXPECT_EQ(0.f, accum);   }
-}
-
-TEST_F(tkernel_test, tkernel_trim)
-{
-    auto fkernel = glkernel::kernel3(4, 2, 8);
-
-    for (glm::uint16 r = 0; r < fkernel.depth(); ++r)
-        for (glm::uint16 t = 0; t < fkernel.height(); ++t)
-            for (glm::uint16 s = 0; s < fkernel.width(); ++s)
-                fkernel.value(s, t, r) = glm::vec3(s, t, r);
-
-    const auto trimmed = fkernel.trimmed(2, 2, 2);
-
-    for (glm::uint16 r = 0; r < trimmed.depth(); ++r)
-        for (glm::uint16 t = 0; t < trimmed.height(); ++t)
-            for (glm::uint16 s = 0; s < trimmed.width(); ++s)
-                EXPECT_EQ(glm::vec3(s, t, r), fkernel.value(s, t, r));
-}
-
-TEST_F(tkernel_test, tkernel1_defaults)
-{
-    const auto fkernel = glkernel::kernel1{};
-
-    EXPECT_EQ(1u, fkernel.size());
-    EXPECT_EQ(1u, fkernel.width());
-    EXPECT_EQ(1u, fkernel.height());
-    EXPECT_EQ(1u, fkernel.depth());
-     
-    EXPECT_EQ(0.f, fkernel.value(0, 0, 0));
- 
-    const auto dkernel = glkernel::dkernel1{};
-
-    EXPECT_EQ(1u, dkernel.size());
-    EXPECT_EQ(1u, dkernel.width());
-    EXPECT_EQ(1u, dkernel.height());
-    EXPECT_EQ(1u, dkernel.depth());
-
-    EXPECT_EQ(0.0, dkernel.value(0, 0, 0));
-}
-
-TEST_F(tkernel_test, tkernel2_defaults)
-{
-    const auto fkernel = glkernel::kernel2{};
-
-    EXPECT_EQ(1u, fkernel.size());
-    EXPECT_EQ(1u, fkernel.width());
-    EXPECT_EQ(1u, fkernel.height());
-    EXPECT_EQ(1u, fkernel.depth());
-
-    EXPECT_EQ(glm::vec2(0.f, 0.f), fkernel.value(0, 0, 0));
-
-    const auto dkernel = glkernel::dkernel2{};
-
-    EXPECT_EQ(1u, dkernel.size());
-    EXPECT_EQ(1u, dkernel.width());
-    EXPECT_EQ(1u, dkernel.height());
-    EXPECT_EQ(1u, dkernel.depth());
-
-    EXPECT_EQ(glm::dvec2(0.0, 0.0), dkernel.value(0, 0, 0));
-}
-
-TEST_F(tkernel_test, tkernel3_defaults)
-{
-    const auto fkernel = glkernel::kernel3{};
-
-    EXPECT_EQ(1u, fkernel.size());
-    EXPECT_EQ(1u, fkernel.width());
-    EXPECT_EQ(1u, fkernel.height());
-    EXPECT_EQ(1u, fkernel.depth());
-
-    EXPECT_EQ(glm::vec3(0.f, 0.f, 0.f), fkernel.value(0, 0, 0));
-
-    const auto dkernel = glkernel::dkernel3{};
-
-    EXPECT_EQ(1u, dkernel.size());
-    EXPECT_EQ(1u, dkernel.width());
-    EXPECT_EQ(1u, dkernel.height());
-    EXPECT_EQ(1u, dkernel.depth());
-
-    EXPECT_EQ(glm::dvec3(0.0, 0.0, 0.0), dkernel.value(0, 0, 0));
-}
-
-TEST_F(tkernel_test, tkernel4_defaults)
-{
-    const auto fkernel = glkernel::kernel4{};
-
-    EXPECT_EQ(1u, fkernel.size());
-    EXPECT_EQ(1u, fkernel.width());
-    EXPECT_EQ(1u, fkernel.height());
-    EXPECT_EQ(1u, fkernel.depth());
-
-    EXPECT_EQ(glm::vec4(0.f, 0.f, 0.f, 0.f), fkernel.value(0, 0, 0));
-
-    const auto dkernel = glkernel::dkernel4{};
-
-    EXPECT_EQ(1u, dkernel.size());
-    EXPECT_EQ(1u, dkernel.width());
-    EXPECT_EQ(1u, dkernel.height());
-    EXPECT_EQ(1u, dkernel.depth());
-
-    EXPECT_EQ(glm::dvec4(0.0, 0.0, 0.0, 0.0), dkernel.value(0, 0, 0));
-}
-
-TEST_F(tkernel_test, tkernel_lengths)
-{
-    const auto fkernel1 = glkernel::kernel1{};
-    EXPECT_EQ(1, fkernel1.length());
-
-    const auto fkernel2 = glkernel::kernel2{};
-    EXPECT_EQ(2, fkernel2.length());
-
-    const auto fkernel3 = glkernel::kernel3{};
-    EXPECT_EQ(3, fkernel3.length());
-
-    const auto fkernel4 = glkernel::kernel4{};
-    EXPECT_EQ(4, fkernel4.length());
-
-    const auto dkernel1 = glkernel::dkernel1{};
-    EXPECT_EQ(1, dkernel1.length());
-
-    const auto dkernel2 = glkernel::dkernel2{};
-    EXPECT_EQ(2, dkernel2.length());
-
-    const auto dkernel3 = glkernel::dkernel3{};
-    EXPECT_EQ(3, dkernel3.length());
-
-    const auto dkernel4 = glkernel::dkernel4{};
-    EXPECT_EQ(4, dkernel4.length());
-}
+
+#include <gmock/gmock.h>
+
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <glkernel/Kernel.h>
+
+
+class tkernel_test: public testing::Test
+ {
+ public:
+ };
+
+// operator taking its argument by value, i.e., moving from rvalue arguments
+class offsets_operator
+{
+public:
+    offsets_operator(const size_t /*size*/, const glm::length_t coefficient, std::vector<float> offsets)
+    : m_offset{ offsets.size() > 2 ? offsets[coefficient] : -1.f }
+    {
+    }
+
+    float operator()(const size_t index) const
+    {
+        return static_cast<float>(index) + m_offset;
+    }
+
+protected:
+    float m_offset;
+};
+
+TEST_F(tkernel_test, tkernel_indexed_value_access)
+{
+    auto fkernel = glkernel::kernel1(2, 4, 8);
+
+    EXPECT_EQ(64u, fkernel.size());
+    EXPECT_EQ( 2u, fkernel.width());
+    EXPECT_EQ( 4u, fkernel.height());
+    EXPECT_EQ( 8u, fkernel.depth());
+
+    // check if a value set in kernel via spatial reference 
+    // equals the value at the expected index ...
+
+    const auto findex = fkernel.index(1, 2, 3);
+    EXPECT_EQ(static_cast<unsigned int>(2 * 4 * 3 + 2 * 2 + 1), findex);
+
+    fkernel[findex] = 1.f;
+    EXPECT_EQ(1.f, fkernel.value(1, 2, 3));
+}
+
+TEST_F(tkernel_test, tkernel_position_conformance)
+{
+    auto fkernel = glkernel::kernel1(2, 3, 4);
+
+    EXPECT_EQ(24u, fkernel.size());
+    EXPECT_EQ(2u, fkernel.width());
+    EXPECT_EQ(3u, fkernel.height());
+    EXPECT_EQ(4u, fkernel.depth());
+
+    // check if the index-position relation is bijectiv
+
+    const auto findex = fkernel.index(1, 2, 3);
+    EXPECT_EQ(static_cast<unsigned int>(2 * 3 * 3 + 2 * 2 + 1), findex);
+
+    fkernel[findex] = 1.f;
+    EXPECT_EQ(1.f, fkernel.value(1, 2, 3));
+
+    const auto fpos = fkernel.position(findex);
+    EXPECT_EQ(1u, fpos[0]);
+    EXPECT_EQ(2u, fpos[1]);
+    EXPECT_EQ(3u, fpos[2]);
+}
+
+TEST_F(tkernel_test, tkernel_data_access)
+{
+    auto fkernel = glkernel::kernel1(8, 2, 4);
+
+    EXPECT_EQ(64u, fkernel.size());
+    EXPECT_EQ( 8u, fkernel.width());
+    EXPECT_EQ( 2u, fkernel.height());
+    EXPECT_EQ( 4u, fkernel.depth());
+
+    // check if a value set in kernel via spatial reference 
+    // equals the value at the expected index ...
+
+    const auto findex = fkernel.index(2, 1, 3);
+    EXPECT_EQ(static_cast<unsigned int>(8 * 2 * 3 + 8 * 1 + 2), findex);
+
+    fkernel[findex] = 1.f;
+    EXPECT_EQ(1.f, fkernel.data()[findex]);
+}
+
+TEST_F(tkernel_test, tkernel_reset)
+{
+    auto fkernel = glkernel::kernel1(1024);
+
+    EXPECT_EQ(1024u, fkernel.size());
+    EXPECT_EQ(1024u, fkernel.width());
+    EXPECT_EQ(   1u, fkernel.height());
+    EXPECT_EQ(   1u, fkernel.depth());
+
+    {   auto accum = 0.f; // checksum
+        for (size_t i = 0; i < fkernel.size(); accum += fkernel[i++]);
+        EXPECT_EQ(0.f, accum);   }
+
+    for (size_t i = 0; i < fkernel.size(); ++i)
+        fkernel[i] = 1.0f;
+
+    {   auto accum = 0.f; // checksum
+        for (size_t i = 0; i < fkernel.size(); accum += fkernel[i++]);
+        EXPECT_EQ(static_cast<float>(fkernel.size()), accum);   }
+
+    fkernel.reset();
+
+    {   auto accum = 0.f; // checksum
+        for (size_t i = 0; i < fkernel.size(); accum += fkernel[i++]);
+        EXPECT_EQ(0.f, accum);   }
+}
+
+TEST_F(tkernel_test, tkernel_trim)
+{
+    auto fkernel = glkernel::kernel3(4, 2, 8);
+
+    for (glm::uint16 r = 0; r < fkernel.depth(); ++r)
+        for (glm::uint16 t = 0; t < fkernel.height(); ++t)
+            for (glm::uint16 s = 0; s < fkernel.width(); ++s)
+                fkernel.value(s, t, r) = glm::vec3(s, t, r);
+
+    const auto trimmed = fkernel.trimmed(2, 2, 2);
+
+    for (glm::uint16 r = 0; r < trimmed.depth(); ++r)
+        for (glm::uint16 t = 0; t < trimmed.height(); ++t)
+            for (glm::uint16 s = 0; s < trimmed.width(); ++s)
+                EXPECT_EQ(glm::vec3(s, t, r), fkernel.value(s, t, r));
+}
+
+TEST_F(tkernel_test, tkernel1_defaults)
+{
+    const auto fkernel = glkernel::kernel1{};
+
+    EXPECT_EQ(1u, fkernel.size());
+    EXPECT_EQ(1u, fkernel.width());
+    EXPECT_EQ(1u, fkernel.height());
+    EXPECT_EQ(1u, fkernel.depth());
+     
+    EXPECT_EQ(0.f, fkernel.value(0, 0, 0));
+ 
+    const auto dkernel = glkernel::dkernel1{};
+
+    EXPECT_EQ(1u, dkernel.size());
+    EXPECT_EQ(1u, dkernel.width());
+    EXPECT_EQ(1u, dkernel.height());
+    EXPECT_EQ(1u, dkernel.depth());
+
+    EXPECT_EQ(0.0, dkernel.value(0, 0, 0));
+}
+
+TEST_F(tkernel_test, tkernel2_defaults)
+{
+    const auto fkernel = glkernel::kernel2{};
+
+    EXPECT_EQ(1u, fkernel.size());
+    EXPECT_EQ(1u, fkernel.width());
+    EXPECT_EQ(1u, fkernel.height());
+    EXPECT_EQ(1u, fkernel.depth());
+
+    EXPECT_EQ(glm::vec2(0.f, 0.f), fkernel.value(0, 0, 0));
+
+    const auto dkernel = glkernel::dkernel2{};
+
+    EXPECT_EQ(1u, dkernel.size());
+    EXPECT_EQ(1u, dkernel.width());
+    EXPECT_EQ(1u, dkernel.height());
+    EXPECT_EQ(1u, dkernel.depth());
+
+    EXPECT_EQ(glm::dvec2(0.0, 0.0), dkernel.value(0, 0, 0));
+}
+
+TEST_F(tkernel_test, tkernel3_defaults)
+{
+    const auto fkernel = glkernel::kernel3{};
+
+    EXPECT_EQ(1u, fkernel.size());
+    EXPECT_EQ(1u, fkernel.width());
+    EXPECT_EQ(1u, fkernel.height());
+    EXPECT_EQ(1u, fkernel.depth());
+
+    EXPECT_EQ(glm::vec3(0.f, 0.f, 0.f), fkernel.value(0, 0, 0));
+
+    const auto dkernel = glkernel::dkernel3{};
+
+    EXPECT_EQ(1u, dkernel.size());
+    EXPECT_EQ(1u, dkernel.width());
+    EXPECT_EQ(1u, dkernel.height());
+    EXPECT_EQ(1u, dkernel.depth());
+
+    EXPECT_EQ(glm::dvec3(0.0, 0.0, 0.0), dkernel.value(0, 0, 0));
+}
+
+TEST_F(tkernel_test, tkernel4_defaults)
+{
+    const auto fkernel = glkernel::kernel4{};
+
+    EXPECT_EQ(1u, fkernel.size());
+    EXPECT_EQ(1u, fkernel.width());
+    EXPECT_EQ(1u, fkernel.height());
+    EXPECT_EQ(1u, fkernel.depth());
+
+    EXPECT_EQ(glm::vec4(0.f, 0.f, 0.f, 0.f), fkernel.value(0, 0, 0));
+
+    const auto dkernel = glkernel::dkernel4{};
+
+    EXPECT_EQ(1u, dkernel.size());
+    EXPECT_EQ(1u, dkernel.width());
+    EXPECT_EQ(1u, dkernel.height());
+    EXPECT_EQ(1u, dkernel.depth());
+
+    EXPECT_EQ(glm::dvec4(0.0, 0.0, 0.0, 0.0), dkernel.value(0, 0, 0));
+}
+
+TEST_F(tkernel_test, tkernel_lengths)
+{
+    const auto fkernel1 = glkernel::kernel1{};
+    EXPECT_EQ(1, fkernel1.length());
+
+    const auto fkernel2 = glkernel::kernel2{};
+    EXPECT_EQ(2, fkernel2.length());
+
+    const auto fkernel3 = glkernel::kernel3{};
+    EXPECT_EQ(3, fkernel3.length());
+
+    const auto fkernel4 = glkernel::kernel4{};
+    EXPECT_EQ(4, fkernel4.length());
+
+    const auto dkernel1 = glkernel::dkernel1{};
+    EXPECT_EQ(1, dkernel1.length());
+
+    const auto dkernel2 = glkernel::dkernel2{};
+    EXPECT_EQ(2, dkernel2.length());
+
+    const auto dkernel3 = glkernel::dkernel3{};
+    EXPECT_EQ(3, dkernel3.length());
+
+    const auto dkernel4 = glkernel::dkernel4{};
+    EXPECT_EQ(4, dkernel4.length());
+}
+
+TEST_F(tkernel_test, tkernel_soa_value_access)
+{
+    auto fkernel = glkernel::tkernel<glm::vec3, glkernel::layout::soa>(3, 2, 5);
+
+    EXPECT_EQ(30u, fkernel.size());
+    EXPECT_EQ( 3, fkernel.length());
+
+    for (glm::uint16 r = 0; r < fkernel.depth(); ++r)
+        for (glm::uint16 t = 0; t < fkernel.height(); ++t)
+            for (glm::uint16 s = 0; s < fkernel.width(); ++s)
+                fkernel.value(s, t, r) = glm::vec3(s, t, r);
+
+    const auto findex = fkernel.index(2, 1, 3);
+    EXPECT_EQ(glm::vec3(2.f, 1.f, 3.f), static_cast<glm::vec3>(fkernel[findex]));
+
+    fkernel[findex][1] = 7.f;
+    EXPECT_EQ(glm::vec3(2.f, 7.f, 3.f), static_cast<glm::vec3>(fkernel.value(2, 1, 3)));
+
+    // each coefficient is stored contiguously and cache line aligned
+    for (glm::length_t c = 0; c < fkernel.length(); ++c)
+    {
+        EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(fkernel.data(c)) % 64);
+        EXPECT_EQ(fkernel.value(2, 1, 3)[c], fkernel.data(c)[findex]);
+    }
+
+    const auto trimmed = fkernel.trimmed(2, 2, 2);
+    EXPECT_EQ(glm::vec3(1.f, 1.f, 1.f), trimmed.value(1, 1, 1));
+
+    fkernel.reset();
+    EXPECT_EQ(glm::vec3(0.f), static_cast<glm::vec3>(fkernel.value(2, 1, 3)));
+}
+
+TEST_F(tkernel_test, tkernel_view_pitched_access)
+{
+    // 3x2x2 values with rows padded to 4 values and slices padded by one additional row
+    auto memory = std::vector<float>(4 * 3 * 2, -1.f);
+    auto fview = glkernel::kernel1_view(memory.data(), 3, 2, 2, 4 * sizeof(float), 12 * sizeof(float));
+
+    EXPECT_EQ(12u, fview.size());
+    EXPECT_FALSE(fview.contiguous());
+
+    fview.reset();
+    for (size_t i = 0; i < fview.size(); ++i)
+        fview[i] = static_cast<float>(i);
+
+    EXPECT_EQ(memory.data() + 12 + 4 + 2, fview.element(fview.index(2, 1, 1)));
+    EXPECT_EQ(11.f, fview.value(2, 1, 1));
+
+    // padding remains untouched
+    EXPECT_EQ(-1.f, memory[3]);
+    EXPECT_EQ(-1.f, memory[8]);
+    EXPECT_EQ(-1.f, memory[23]);
+
+    auto i = 0.f;
+    for (const auto & v : fview)
+        EXPECT_EQ(i++, v);
+    EXPECT_EQ(12, fview.end() - fview.begin());
+
+    const auto trimmed = fview.trimmed(2, 2, 1);
+    EXPECT_EQ(4.f, trimmed.value(1, 1, 0));
+}
+
+TEST_F(tkernel_test, tkernel_view_of_kernel)
+{
+    auto fkernel = glkernel::kernel3(4, 4);
+    auto fview = glkernel::kernel3_view(fkernel);
+
+    EXPECT_TRUE(fview.contiguous());
+    EXPECT_EQ(fkernel.extent(), fview.extent());
+
+    fview.value(3, 2) = glm::vec3(1.f, 2.f, 3.f);
+    EXPECT_EQ(glm::vec3(1.f, 2.f, 3.f), fkernel.value(3, 2));
+    EXPECT_EQ(fkernel.data(), fview.data());
+}
+
+TEST_F(tkernel_test, tkernel_large_extent)
+{
+    // extents beyond 16 bit per side, with more values than addressable by 32 bit
+    const auto extent = glkernel::kernel_extent(70000, 70000, 3);
+
+    const auto findex = extent.index(69999, 69998, 2);
+    EXPECT_EQ(size_t{ 2 } * 70000 * 70000 + size_t{ 69998 } * 70000 + 69999, findex);
+    EXPECT_EQ(glm::u32vec3(69999, 69998, 2), extent.position(findex));
+
+    // 128k wide strip
+    auto fkernel = glkernel::kernel1(131072, 2);
+    EXPECT_EQ(262144u, fkernel.size());
+
+    fkernel.value(131071, 1) = 1.f;
+    EXPECT_EQ(1.f, fkernel[fkernel.size() - 1]);
+    EXPECT_EQ(glm::u32vec3(131071, 1, 0), fkernel.position(fkernel.size() - 1));
+}
+
+TEST_F(tkernel_test, static_tkernel_access)
+{
+    using kernel_type = glkernel::static_kernel3<4, 2, 3>;
+
+    static_assert(kernel_type::size() == 24, "static kernel size mismatch");
+    static_assert(kernel_type::length() == 3, "static kernel length mismatch");
+    static_assert(kernel_type::index(3, 1, 2) == 23, "static kernel index mismatch");
+    static_assert(sizeof(kernel_type) == 24 * sizeof(glm::vec3), "static kernel is expected to store values only");
+
+    static constexpr auto s_zero = kernel_type{ };
+    static_assert(s_zero.component(23, 2) == 0.f, "static kernel is expected to be zero initialized");
+
+    EXPECT_EQ(glm::u32vec3(4, 2, 3), kernel_type::extent());
+    EXPECT_EQ(glm::vec3(0.f), s_zero.value(3, 1, 2));
+}
+
+TEST_F(tkernel_test, tkernel_for_each_rvalue_arguments)
+{
+    // every thread and coefficient constructs its operator from the same (not moved-from) arguments
+    auto fkernel = glkernel::kernel3(64, 64);
+    fkernel.for_each<offsets_operator>(std::vector<float>{ 0.25f, 0.5f, 0.75f });
+
+    auto soa = glkernel::tkernel<glm::vec3, glkernel::layout::soa>(64, 64);
+    soa.for_each<offsets_operator>(std::vector<float>{ 0.25f, 0.5f, 0.75f });
+
+    for (size_t i = 0; i < fkernel.size(); ++i)
+    {
+        const auto expected = glm::vec3(static_cast<float>(i)) + glm::vec3(0.25f, 0.5f, 0.75f);
+        EXPECT_EQ(expected, fkernel[i]);
+        EXPECT_EQ(expected, static_cast<glm::vec3>(soa[i]));
+    }
+}
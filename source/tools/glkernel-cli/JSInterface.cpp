@@ -553,7 +553,7 @@ void JSInterface::sequence_uniform(cppexpose::Object* obj, const cppexpose::Vari
 }
 
 
-void JSInterface::shuffle_bucket_permutate(cppexpose::Object* obj, glm::uint16 subkernel_width, glm::uint16 subkernel_height, glm::uint16 subkernel_depth, bool permutate_per_bucket)
+void JSInterface::shuffle_bucket_permutate(cppexpose::Object* obj, glm::uint32 subkernel_width, glm::uint32 subkernel_height, glm::uint32 subkernel_depth, bool permutate_per_bucket)
 {
     if (auto kernelObj = dynamic_cast<Kernel1Object*>(obj))
     {
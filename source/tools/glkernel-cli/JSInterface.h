@@ -32,7 +32,7 @@ public:
     void sample_golden_point_set(cppexpose::Object* obj);
     void scale_range(cppexpose::Object* obj, float rangeToLower, float rangeToUpper, float rangeFromLower, float rangeFromUpper);
     void sequence_uniform(cppexpose::Object* obj, const cppexpose::Variant& range_min, const cppexpose::Variant& range_max);
-    void shuffle_bucket_permutate(cppexpose::Object* obj, glm::uint16 subkernel_width, glm::uint16 subkernel_height, glm::uint16 subkernel_depth, bool permutate_per_bucket);
+    void shuffle_bucket_permutate(cppexpose::Object* obj, glm::uint32 subkernel_width, glm::uint32 subkernel_height, glm::uint32 subkernel_depth, bool permutate_per_bucket);
     void shuffle_bayer(cppexpose::Object* obj);
     void shuffle_random(cppexpose::Object* obj, size_t start);
     void sort_distance(cppexpose::Object* obj, const cppexpose::Variant& origin);
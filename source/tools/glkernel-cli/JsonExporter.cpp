@@ -79,15 +79,15 @@ cppexpose::Variant JsonExporter::toJsonArray(const glkernel::tkernel<T> & kernel
 {
     auto kernelArray = cppexpose::Variant::array();
 
-    for (auto z = 0; z < kernel.depth(); ++z)
+    for (glm::uint32 z = 0; z < kernel.depth(); ++z)
     {
         auto heightArray = cppexpose::Variant::array();
 
-        for (auto y = 0; y < kernel.height(); ++y)
+        for (glm::uint32 y = 0; y < kernel.height(); ++y)
         {
             auto widthArray = cppexpose::Variant::array();
 
-            for (auto x = 0; x < kernel.width(); ++x)
+            for (glm::uint32 x = 0; x < kernel.width(); ++x)
             {
                 const T& cell = kernel.value(x, y, z);
                 appendCell(widthArray.asArray(), cell);
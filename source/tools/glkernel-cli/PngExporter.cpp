@@ -109,9 +109,9 @@ png_bytepp PngExporter::toPng(const glkernel::tkernel<T> & kernel, const int cha
 
     const auto range = max - min;
 
-    for (auto y = 0; y < kernel.height(); ++y)
+    for (glm::uint32 y = 0; y < kernel.height(); ++y)
     {
-        for (auto x = 0; x < kernel.width(); ++x)
+        for (glm::uint32 x = 0; x < kernel.width(); ++x)
         {
             auto value = kernel.value(x, y, 0);
             auto normalizedValue = (value - min) / range;
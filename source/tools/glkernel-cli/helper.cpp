@@ -1,9 +1,9 @@
 #include "helper.h"
 
-#include <algorithm>
-#include <vector>
+#include <stdexcept>
 
 #include <glkernel/Kernel.h>
+#include <glkernel/reduce.h>
 
 void throwIf(bool condition, const std::string& msg)
 {
@@ -23,77 +23,22 @@ void throwIfNot(bool condition, const std::string& msg)
 
 std::pair<float, float> findMinMaxElements(const glkernel::tkernel<float> & kernel)
 {
-    const auto minmax = std::minmax_element(kernel.cbegin(), kernel.cend());
-    return std::make_pair(*minmax.first, *minmax.second);
+    return glkernel::reduce::coefficient_minmax(kernel);
 }
 
 std::pair<float, float> findMinMaxElements(const glkernel::tkernel<glm::vec2> & kernel)
 {
-    auto min = std::numeric_limits<float>::max();
-    auto max = std::numeric_limits<float>::min();
-
-    for (const auto & element : kernel)
-    {
-        const auto x = element.x;
-        const auto y = element.y;
-
-        min = x < min ? x : min;
-        min = y < min ? y : min;
-
-        max = x > max ? x : max;
-        max = y > max ? y : max;
-    }
-
-    return std::make_pair(min, max);
+    return glkernel::reduce::coefficient_minmax(kernel);
 }
 
 std::pair<float, float> findMinMaxElements(const glkernel::tkernel<glm::vec3> & kernel)
 {
-    auto min = std::numeric_limits<float>::max();
-    auto max = std::numeric_limits<float>::min();
-
-    for (const auto & element : kernel)
-    {
-        const auto x = element.x;
-        const auto y = element.y;
-        const auto z = element.z;
-
-        min = x < min ? x : min;
-        min = y < min ? y : min;
-        min = z < min ? z : min;
-
-        max = x > max ? x : max;
-        max = y > max ? y : max;
-        max = z > max ? z : max;
-    }
-
-    return std::make_pair(min, max);
+    return glkernel::reduce::coefficient_minmax(kernel);
 }
 
 std::pair<float, float> findMinMaxElements(const glkernel::tkernel<glm::vec4> & kernel)
 {
-    auto min = std::numeric_limits<float>::max();
-    auto max = std::numeric_limits<float>::min();
-
-    for (const auto & element : kernel)
-    {
-        const auto x = element.x;
-        const auto y = element.y;
-        const auto z = element.z;
-        const auto w = element.w;
-
-        min = x < min ? x : min;
-        min = y < min ? y : min;
-        min = z < min ? z : min;
-        min = w < min ? w : min;
-
-        max = x > max ? x : max;
-        max = y > max ? y : max;
-        max = z > max ? z : max;
-        max = w > max ? w : max;
-    }
-
-    return std::make_pair(min, max);
+    return glkernel::reduce::coefficient_minmax(kernel);
 }
 
 bool canBeFloat(const cppexpose::Variant & v)
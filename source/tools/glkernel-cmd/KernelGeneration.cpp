@@ -319,9 +319,9 @@ bool generateKernelFromDescription(cppexpose::Variant & kernelVariant, const std
 
     auto components = initKernelMap->at("components").value<int>();
 
-    auto width = initKernelMap->at("width").value<glm::uint16>();
-    auto height = initKernelMap->at("height").value<glm::uint16>();
-    auto depth = initKernelMap->at("depth").value<glm::uint16>();
+    auto width = initKernelMap->at("width").value<glm::uint32>();
+    auto height = initKernelMap->at("height").value<glm::uint32>();
+    auto depth = initKernelMap->at("depth").value<glm::uint32>();
 
     if (rootMap->find("commands") == rootMap->end())
     {
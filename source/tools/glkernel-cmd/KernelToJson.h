@@ -45,15 +45,15 @@ cppexpose::Variant toJSON(const glkernel::tkernel<T> & kernel)
 {
     cppexpose::Variant zArray = cppexpose::Variant::array();
 
-    for (int z = 0; z < kernel.depth(); ++z)
+    for (glm::uint32 z = 0; z < kernel.depth(); ++z)
     {
         cppexpose::Variant yArray = cppexpose::Variant::array();
 
-        for (int y = 0; y < kernel.height(); ++y)
+        for (glm::uint32 y = 0; y < kernel.height(); ++y)
         {
             cppexpose::Variant xArray = cppexpose::Variant::array();
 
-            for (int x = 0; x < kernel.width(); ++x)
+            for (glm::uint32 x = 0; x < kernel.width(); ++x)
             {
                 cppexpose::Variant elementArray = cppexpose::Variant::array();
 